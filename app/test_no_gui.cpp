@@ -7,6 +7,8 @@
  *   Ideal para ambientes sem X11/GUI como WSL.
  */
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -16,9 +18,15 @@
 #include "imageinfo.hpp"
 #include "conv/grayscale.hpp"
 #include "conv/channel_isolator.hpp"
+#include "conv/color_converter.hpp"
 #include "arit/arithmetic.hpp"
 #include "thre/threshold.hpp"
 #include "histo/histogram.hpp"
+#include "seg/connected_components.hpp"
+#include "filt/median_filter.hpp"
+
+// Número de imagens de resultado salvas (total informado ao final)
+static int saved_images = 0;
 
 /**
  * @brief Salva uma imagem e informa ao usuário
@@ -28,6 +36,7 @@ void save_and_inform(const cv::Mat& image, const std::string& filename, const st
     if (!image.empty())
     {
         cv::imwrite("results/" + filename, image);
+        saved_images++;
         std::cout << "✓ " << description << " -> results/" << filename << std::endl;
     }
     else
@@ -36,6 +45,66 @@ void save_and_inform(const cv::Mat& image, const std::string& filename, const st
     }
 }
 
+/**
+ * @brief Executa uma conversão de cor, compara com cv::cvtColor e informa a
+ *        diferença máxima por canal e a vazão (melhor de 5 execuções)
+ * @param tolerance Maior diferença aceita por valor (documentada na classe)
+ * @param failures Contador incrementado quando a tolerância é excedida
+ */
+cv::Mat check_color_conversion(const std::string& description, const std::function<cv::Mat()>& convert,
+                               const cv::Mat& input, int opencv_code, int tolerance, int& failures)
+{
+    cv::Mat result;
+    double best_seconds = 0.0;
+    for (int execucao = 0; execucao < 5; execucao++)
+    {
+        cv::TickMeter timer;
+        timer.start();
+        result = convert();
+        timer.stop();
+        if (execucao == 0 || timer.getTimeSec() < best_seconds)
+        {
+            best_seconds = timer.getTimeSec();
+        }
+    }
+
+    cv::Mat reference;
+    cv::cvtColor(input, reference, opencv_code);
+
+    if (result.empty() || result.size() != reference.size() || result.type() != reference.type())
+    {
+        std::cout << "   ✗ FALHA " << description << ": resultado vazio ou com formato diferente do cv::cvtColor" << std::endl;
+        failures++;
+        return result;
+    }
+
+    int max_diff = 0;
+    long long differing = 0;
+    for (int linha = 0; linha < result.rows; linha++)
+    {
+        const uchar* pixel = result.ptr<uchar>(linha);
+        const uchar* expected = reference.ptr<uchar>(linha);
+        for (int coluna = 0; coluna < result.cols * 3; coluna++)
+        {
+            const int diff = std::abs(pixel[coluna] - expected[coluna]);
+            max_diff = std::max(max_diff, diff);
+            differing += (diff != 0);
+        }
+    }
+
+    std::cout << "   • " << description << ": diferença máxima " << max_diff << " ("
+        << (100.0 * differing / (3.0 * input.total())) << "% dos valores), "
+        << (input.total() / best_seconds / 1e6) << " Mpixel/s" << std::endl;
+
+    if (max_diff > tolerance)
+    {
+        std::cout << "   ✗ FALHA " << description << ": diferença máxima " << max_diff
+            << " excede a tolerância " << tolerance << std::endl;
+        failures++;
+    }
+    return result;
+}
+
 /**
  * @brief Teste completo sem interface gráfica
  */
@@ -66,6 +135,9 @@ int main()
         "Blobs"
     };
 
+    // Conversões de cor que excederam a tolerância em relação ao cv::cvtColor
+    int color_failures = 0;
+
     // Processa cada imagem
     for (size_t img_idx = 0; img_idx < image_paths.size(); ++img_idx)
     {
@@ -178,6 +250,12 @@ int main()
         cv::Mat gray_hist_viz = hist_proc.visualize_histogram_gray(gray_arithmetic);
         save_and_inform(gray_hist_viz, prefix + "22_histogram_gray.jpg", "Histograma tons de cinza");
 
+        cv::Mat equalized = hist_proc.equalize_histogram(gray_arithmetic);
+        save_and_inform(equalized, prefix + "24_equalized.jpg", "Equalização global");
+
+        cv::Mat clahe = hist_proc.equalize_clahe(gray_arithmetic, 2.0);
+        save_and_inform(clahe, prefix + "25_clahe.jpg", "Equalização CLAHE (limite 2, grade 8x8)");
+
         // Estatísticas do histograma
         std::vector<int> gray_hist = hist_proc.compute_histogram_gray(gray_arithmetic);
         int min_val, max_val;
@@ -189,15 +267,69 @@ int main()
         std::cout << "   • Máximo: " << max_val << std::endl;
         std::cout << "   • Média: " << mean_val << std::endl;
 
+        HistogramProcessor::IntensityStats intensity = hist_proc.compute_intensity_stats(gray_hist);
+        std::cout << "📈 Intensidades em tons de cinza:" << std::endl;
+        std::cout << "   • Faixa: " << intensity.min << " - " << intensity.max << std::endl;
+        std::cout << "   • Média: " << intensity.mean << " (desvio padrão " << intensity.stddev << ")" << std::endl;
+        std::cout << "   • Mediana: " << intensity.median << ", percentil 95: " << hist_proc.compute_percentile(gray_hist, 95.0) << std::endl;
+        std::cout << "   • Entropia: " << intensity.entropy << " bits" << std::endl;
+
+        // Componentes conexos da limiarização binária
+        ConnectedComponents ccl;
+        cv::Mat labels;
+        std::vector<ConnectedComponents::BlobStats> blobs;
+        int num_blobs = ccl.label_components(binary, labels, blobs);
+
+        std::cout << "🔗 Componentes conexos (limiar 128, vizinhança 8): " << num_blobs << std::endl;
+        if (num_blobs > 0)
+        {
+            auto largest = std::max_element(blobs.begin(), blobs.end(),
+                [](const ConnectedComponents::BlobStats& a, const ConnectedComponents::BlobStats& b) { return a.area < b.area; });
+            std::cout << "   • Maior: área " << largest->area << ", centróide ("
+                << largest->centroid_x << ", " << largest->centroid_y << "), caixa "
+                << largest->bounding_box.width << "x" << largest->bounding_box.height << std::endl;
+        }
+
         // Testa recombinação de canais
         cv::Mat recombined = isolator.combine_channels(blue_channel, green_channel, red_channel);
         save_and_inform(recombined, prefix + "23_recombined.jpg", "Canais recombinados");
 
+        // Filtro de mediana (rede de ordenação 3x3 e histogramas deslizantes)
+        MedianFilter median;
+        cv::Mat median_3x3 = median.median_filter(image, 1);
+        save_and_inform(median_3x3, prefix + "26_median_3x3.jpg", "Mediana 3x3");
+
+        cv::Mat median_large = median.median_filter(image, 7);
+        save_and_inform(median_large, prefix + "27_median_15x15.jpg", "Mediana 15x15");
+
+        // Espaços de cor (YCrCb, HSV, Lab), comparados com cv::cvtColor
+        std::cout << "\n🎨 ESPAÇOS DE COR (comparação com cv::cvtColor)" << std::endl;
+        ColorConverter color;
+
+        // Tolerâncias: YCrCb e BGR -> HSV idênticos; HSV -> BGR e Lab a 1 nível
+        cv::Mat ycrcb = check_color_conversion("BGR -> YCrCb", [&]() { return color.bgr_to_ycrcb(image); }, image, cv::COLOR_BGR2YCrCb, 0, color_failures);
+        check_color_conversion("YCrCb -> BGR", [&]() { return color.ycrcb_to_bgr(ycrcb); }, ycrcb, cv::COLOR_YCrCb2BGR, 0, color_failures);
+        save_and_inform(ycrcb, prefix + "28_ycrcb.jpg", "Imagem em YCrCb");
+
+        cv::Mat hsv = check_color_conversion("BGR -> HSV", [&]() { return color.bgr_to_hsv(image); }, image, cv::COLOR_BGR2HSV, 0, color_failures);
+        check_color_conversion("HSV -> BGR", [&]() { return color.hsv_to_bgr(hsv); }, hsv, cv::COLOR_HSV2BGR, 1, color_failures);
+        save_and_inform(hsv, prefix + "29_hsv.jpg", "Imagem em HSV");
+
+        cv::Mat lab = check_color_conversion("BGR -> Lab", [&]() { return color.bgr_to_lab(image); }, image, cv::COLOR_BGR2Lab, 1, color_failures);
+        check_color_conversion("Lab -> BGR", [&]() { return color.lab_to_bgr(lab); }, lab, cv::COLOR_Lab2BGR, 1, color_failures);
+        save_and_inform(lab, prefix + "30_lab.jpg", "Imagem em Lab");
+
         std::cout << "\n✅ Processamento de " << image_names[img_idx] << " concluído!" << std::endl;
         std::cout << "====================================================" << std::endl;
     }
 
     std::cout << "\n====================================================" << std::endl;
+    if (color_failures > 0)
+    {
+        std::cout << "   ❌ " << color_failures << " CONVERSÃO(ÕES) DE COR FORA DA TOLERÂNCIA!" << std::endl;
+        std::cout << "====================================================" << std::endl;
+        return EXIT_FAILURE;
+    }
     std::cout << "   🎉 TODOS OS TESTES CONCLUÍDOS COM SUCESSO!" << std::endl;
     std::cout << "====================================================" << std::endl;
     std::cout << "📁 Resultados salvos em: results/" << std::endl;
@@ -208,9 +340,12 @@ int main()
     std::cout << "   ✓ Operações aritméticas (6 operações)" << std::endl;
     std::cout << "   ✓ Limiarização (5 tipos)" << std::endl;
     std::cout << "   ✓ Isolamento de canais (7 operações)" << std::endl;
-    std::cout << "   ✓ Histogramas (computação e visualização)" << std::endl;
+    std::cout << "   ✓ Histogramas (computação, visualização e equalização)" << std::endl;
     std::cout << "   ✓ Inversão de imagem" << std::endl;
-    std::cout << "\n🚀 Total: " << (image_paths.size() * 23) << " imagens de resultado geradas!" << std::endl;
+    std::cout << "   ✓ Componentes conexos (área, centróide, caixa)" << std::endl;
+    std::cout << "   ✓ Filtro de mediana (3x3 e raio grande)" << std::endl;
+    std::cout << "   ✓ Espaços de cor (YCrCb, HSV e Lab, comparados com cv::cvtColor)" << std::endl;
+    std::cout << "\n🚀 Total: " << saved_images << " imagens de resultado geradas!" << std::endl;
     std::cout << "====================================================" << std::endl;
 
     return EXIT_SUCCESS;
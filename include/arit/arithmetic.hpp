@@ -2,6 +2,7 @@
 #define ARITHMETIC_HPP
 
 #include <opencv2/opencv.hpp>
+#include "lut/point_lut.hpp"
 
 /**
  * Classe ArithmeticOperations
@@ -14,6 +15,12 @@
  * - Operações imagem-imagem e imagem-escalar
  * - Imagens coloridas (3 canais) e em tons de cinza (1 canal)
  * - Tratamento de overflow/underflow com clamping
+ * - Soma/subtração imagem-imagem vetorizadas (SSE2/AVX2/AVX-512) com
+ *   aritmética saturada, idênticas bit a bit ao caminho escalar
+ * - Operações com escalar executadas por tabela de consulta (PointLut),
+ *   que também pode ser obtida e composta com outras operações pontuais
+ * - Multiplicação/divisão imagem-imagem em ponto fixo (produto de 16 bits
+ *   dividido por 255 e tabela de recíprocos), sem aritmética de double
  *
  * Uso típico:
  *   ArithmeticOperations arith{};
@@ -55,7 +62,7 @@ class ArithmeticOperations
      * Multiplica duas imagens pixel a pixel.
      * @param img1 Primeira imagem (CV_8UC1 ou CV_8UC3)
      * @param img2 Segunda imagem (mesmo tipo e dimensões de img1)
-     * @return Imagem resultante com clamping [0, 255]
+     * @return Imagem resultante floor(img1 * img2 / 255)
      */
     cv::Mat multiply_images(const cv::Mat& img1, const cv::Mat& img2);
 
@@ -63,7 +70,7 @@ class ArithmeticOperations
      * Divide duas imagens pixel a pixel.
      * @param img1 Primeira imagem (dividendo) (CV_8UC1 ou CV_8UC3)
      * @param img2 Segunda imagem (divisor) (mesmo tipo e dimensões de img1)
-     * @return Imagem resultante com proteção contra divisão por zero
+     * @return Imagem resultante min(255, floor(img1 * 255 / img2)); divisor zero resulta em 255
      */
     cv::Mat divide_images(const cv::Mat& img1, const cv::Mat& img2);
 
@@ -101,6 +108,37 @@ class ArithmeticOperations
      */
     cv::Mat divide_scalar(const cv::Mat& img, double scalar);
 
+    // ================ Tabelas de consulta (operações pontuais) ================
+
+    /**
+     * Constrói a tabela equivalente a add_scalar (para composição com PointLut::then).
+     * @param scalar Valor a ser somado
+     * @return Tabela com table[v] = clamp(v + scalar)
+     */
+    PointLut add_scalar_lut(double scalar);
+
+    /**
+     * Constrói a tabela equivalente a subtract_scalar.
+     * @param scalar Valor a ser subtraído
+     * @return Tabela com table[v] = clamp(v - scalar)
+     */
+    PointLut subtract_scalar_lut(double scalar);
+
+    /**
+     * Constrói a tabela equivalente a multiply_scalar.
+     * @param scalar Valor multiplicador
+     * @return Tabela com table[v] = clamp(v * scalar)
+     */
+    PointLut multiply_scalar_lut(double scalar);
+
+    /**
+     * Constrói a tabela equivalente a divide_scalar.
+     * @param scalar Valor divisor (deve ser != 0)
+     * @return Tabela com table[v] = clamp(v / scalar); vazia (empty()) se
+     *         scalar == 0, como o Mat vazio de divide_scalar
+     */
+    PointLut divide_scalar_lut(double scalar);
+
     private:
         /**
          * Aplica clamping a um valor para o range [0, 255].
@@ -116,6 +154,13 @@ class ArithmeticOperations
      * @return true se compatíveis, false caso contrário
      */
     bool are_images_compatible(const cv::Mat& img1, const cv::Mat& img2);
+
+    /**
+     * Verifica se a imagem é de um tipo suportado pelos kernels de 8 bits.
+     * @param img Imagem a ser verificada
+     * @return true se CV_8UC1 ou CV_8UC3, false caso contrário
+     */
+    bool is_supported_type(const cv::Mat& img);
 };
 
 #endif // ARITHMETIC_HPP
@@ -0,0 +1,139 @@
+#ifndef BGR_SIMD_HPP
+#define BGR_SIMD_HPP
+
+#include <cstdint>
+
+// AVX2 implica SSSE3, mas o MSVC com /arch:AVX2 define apenas __AVX2__;
+// BGR_SIMD_SSSE3 marca em um só lugar a disponibilidade de pshufb.
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define BGR_SIMD_SSSE3 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Rotinas internas de separação/junção de pixels BGR intercalados
+ * -----------------------------------------------------------------
+ * Compartilhadas pelos kernels vetorizados do módulo conv (GrayScale,
+ * ColorConverter, ChannelIsolator). Cada bloco de 16 pixels BGR ocupa
+ * 48 bytes (3 registradores de 16 bytes); pshufb move os bytes de cada
+ * canal para a posição final e os três resultados parciais são unidos por OR.
+ *
+ * Disponível apenas com SSSE3 (128 bits, BGR_SIMD_SSSE3) e AVX2 (256 bits);
+ * os chamadores mantêm um laço escalar para as colunas restantes e para
+ * outras CPUs.
+ */
+namespace bgr_simd
+{
+#if defined(BGR_SIMD_SSSE3)
+    // Separação: DEINTERLEAVE[canal * 3 + bloco] leva os bytes do canal no
+    // bloco de entrada para a posição final; -1 zera a posição.
+    alignas(16) inline constexpr int8_t DEINTERLEAVE[9][16] = {
+        { 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13 },
+        { 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14 },
+        { 2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1 },
+        { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15 }
+    };
+
+    // Junção: INTERLEAVE[canal * 3 + bloco] leva o plano do canal para as
+    // posições que ele ocupa no bloco de saída.
+    alignas(16) inline constexpr int8_t INTERLEAVE[9][16] = {
+        { 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5 },
+        { -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1 },
+        { -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1 },
+        { -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1 },
+        { 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10 },
+        { -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1 },
+        { -1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1 },
+        { -1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1 },
+        { 10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15 }
+    };
+
+    inline __m128i mask_128(const int8_t (*table)[16], int index)
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(table[index]));
+    }
+
+    /**
+     * Separa 16 pixels BGR em três vetores de 16 bytes (B, G, R).
+     */
+    inline void deinterleave_bgr_128(const uint8_t* p, __m128i& b, __m128i& g, __m128i& r)
+    {
+        const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+        const __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+        __m128i* planes[3] = { &b, &g, &r };
+        for (int canal = 0; canal < 3; canal++)
+        {
+            *planes[canal] = _mm_or_si128(_mm_or_si128(
+                _mm_shuffle_epi8(c0, mask_128(DEINTERLEAVE, canal * 3)),
+                _mm_shuffle_epi8(c1, mask_128(DEINTERLEAVE, canal * 3 + 1))),
+                _mm_shuffle_epi8(c2, mask_128(DEINTERLEAVE, canal * 3 + 2)));
+        }
+    }
+
+    /**
+     * Junta três vetores de 16 bytes (B, G, R) em 16 pixels BGR (48 bytes).
+     */
+    inline void interleave_bgr_128(__m128i b, __m128i g, __m128i r, uint8_t* p)
+    {
+        for (int bloco = 0; bloco < 3; bloco++)
+        {
+            const __m128i out = _mm_or_si128(_mm_or_si128(
+                _mm_shuffle_epi8(b, mask_128(INTERLEAVE, bloco)),
+                _mm_shuffle_epi8(g, mask_128(INTERLEAVE, 3 + bloco))),
+                _mm_shuffle_epi8(r, mask_128(INTERLEAVE, 6 + bloco)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16 * bloco), out);
+        }
+    }
+#endif
+
+#if defined(__AVX2__)
+    /**
+     * Separa 32 pixels BGR: cada metade de 128 bits recebe 16 pixels
+     * consecutivos, então as mesmas máscaras pshufb valem nas duas metades.
+     */
+    inline void deinterleave_bgr_256(const uint8_t* p, __m256i& b, __m256i& g, __m256i& r)
+    {
+        const __m256i c0 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), 1);
+        const __m256i c1 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 64)), 1);
+        const __m256i c2 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 80)), 1);
+        __m256i* planes[3] = { &b, &g, &r };
+        for (int canal = 0; canal < 3; canal++)
+        {
+            *planes[canal] = _mm256_or_si256(_mm256_or_si256(
+                _mm256_shuffle_epi8(c0, _mm256_broadcastsi128_si256(mask_128(DEINTERLEAVE, canal * 3))),
+                _mm256_shuffle_epi8(c1, _mm256_broadcastsi128_si256(mask_128(DEINTERLEAVE, canal * 3 + 1)))),
+                _mm256_shuffle_epi8(c2, _mm256_broadcastsi128_si256(mask_128(DEINTERLEAVE, canal * 3 + 2))));
+        }
+    }
+
+    /**
+     * Junta 32 pixels (metade baixa: pixels 0-15, alta: 16-31) em 96 bytes BGR.
+     */
+    inline void interleave_bgr_256(__m256i b, __m256i g, __m256i r, uint8_t* p)
+    {
+        for (int bloco = 0; bloco < 3; bloco++)
+        {
+            const __m256i out = _mm256_or_si256(_mm256_or_si256(
+                _mm256_shuffle_epi8(b, _mm256_broadcastsi128_si256(mask_128(INTERLEAVE, bloco))),
+                _mm256_shuffle_epi8(g, _mm256_broadcastsi128_si256(mask_128(INTERLEAVE, 3 + bloco)))),
+                _mm256_shuffle_epi8(r, _mm256_broadcastsi128_si256(mask_128(INTERLEAVE, 6 + bloco))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16 * bloco), _mm256_castsi256_si128(out));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 48 + 16 * bloco), _mm256_extracti128_si256(out, 1));
+        }
+    }
+#endif
+}
+
+#endif // BGR_SIMD_HPP
@@ -0,0 +1,62 @@
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Classe BufferPool
+ * -----------------
+ * Conjunto de buffers CV_8UC1 reutilizáveis, procurados por tamanho.
+ * Usado pelas variantes *_pooled de GrayScale e ChannelIsolator para
+ * processar sequências de quadros sem alocar a cada quadro.
+ *
+ * Notas:
+ * - Não é thread-safe: cada thread deve usar o seu próprio conjunto (e,
+ *   portanto, a sua própria instância da classe que o contém).
+ * - Os buffers entregues por acquire têm conteúdo indefinido.
+ *
+ * Uso típico:
+ *   BufferPool pool{};
+ *   cv::Mat buffer = pool.acquire(cv::Size(640, 480));
+ *   ...
+ *   pool.recycle(buffer);
+ */
+class BufferPool
+{
+    public:
+        /**
+         * Construtor padrão (conjunto vazio).
+         */
+    BufferPool();
+
+    /**
+     * Destrutor.
+     */
+    ~BufferPool();
+
+    /**
+     * Retira do conjunto um buffer CV_8UC1 do tamanho pedido (ou aloca um).
+     * @param size Tamanho do buffer
+     * @return Buffer CV_8UC1 com conteúdo indefinido
+     */
+    cv::Mat acquire(cv::Size size);
+
+    /**
+     * Devolve um buffer ao conjunto para reutilização; buffer fica vazio.
+     * Buffers vazios ou de outro tipo são apenas descartados.
+     * @param buffer Buffer obtido de acquire
+     */
+    void recycle(cv::Mat& buffer);
+
+    /**
+     * Libera todos os buffers guardados no conjunto.
+     */
+    void clear();
+
+    private:
+        // Buffers CV_8UC1 disponíveis para reutilização.
+    std::vector<cv::Mat> buffers_;
+};
+
+#endif // BUFFER_POOL_HPP
@@ -2,6 +2,8 @@
 #define CHANNEL_ISOLATOR_HPP
 
 #include <opencv2/opencv.hpp>
+#include "conv/buffer_pool.hpp"
+#include "lut/point_lut.hpp"
 
 /**
  * Classe ChannelIsolator
@@ -19,6 +21,16 @@
  *   ChannelIsolator isolator{};
  *   cv::Mat red_channel = isolator.extract_red_channel(bgr_img);
  *   cv::Mat only_red = isolator.isolate_red_channel(bgr_img);
+ *
+ *   // Três planos em uma única leitura da imagem
+ *   cv::Mat blue, green, red;
+ *   isolator.split_channels(bgr_img, blue, green, red);
+ *
+ * Notas:
+ * - split_channels_pooled, recycle_buffer e release_buffers alteram o
+ *   conjunto interno de buffers (BufferPool) e não são thread-safe: não
+ *   compartilhe a mesma instância entre threads nessas chamadas. As demais
+ *   operações não guardam estado.
  */
 class ChannelIsolator
 {
@@ -74,6 +86,43 @@ class ChannelIsolator
      */
     cv::Mat extract_channel(const cv::Mat& img, Channel channel);
 
+    /**
+     * Separa os três canais em uma única passada sobre a imagem (separação
+     * vetorizada por pshufb com SSSE3/AVX2), em vez de reler a imagem
+     * intercalada uma vez por canal.
+     * Os planos só são (re)alocados se não forem CV_8UC1 do tamanho da
+     * imagem; reutilizá-los entre quadros evita alocações.
+     * @param img Imagem colorida de entrada (CV_8UC3 BGR)
+     * @param blue Saída: canal azul (CV_8UC1)
+     * @param green Saída: canal verde (CV_8UC1)
+     * @param red Saída: canal vermelho (CV_8UC1)
+     * @return true se separado, false se a imagem for inválida
+     */
+    bool split_channels(const cv::Mat& img, cv::Mat& blue, cv::Mat& green, cv::Mat& red);
+
+    /**
+     * Como split_channels, com os planos retirados do conjunto interno de
+     * buffers (por tamanho). Devolva-os com recycle_buffer quando não forem
+     * mais usados.
+     * @param img Imagem colorida de entrada (CV_8UC3 BGR)
+     * @param blue Saída: canal azul (CV_8UC1)
+     * @param green Saída: canal verde (CV_8UC1)
+     * @param red Saída: canal vermelho (CV_8UC1)
+     * @return true se separado, false se a imagem for inválida
+     */
+    bool split_channels_pooled(const cv::Mat& img, cv::Mat& blue, cv::Mat& green, cv::Mat& red);
+
+    /**
+     * Devolve um plano ao conjunto para reutilização; buffer fica vazio.
+     * @param buffer Plano obtido de split_channels_pooled
+     */
+    void recycle_buffer(cv::Mat& buffer);
+
+    /**
+     * Libera todos os planos guardados no conjunto.
+     */
+    void release_buffers();
+
     // ================ Isolamento de canais (mantém imagem colorida) ================
 
     /**
@@ -124,6 +173,13 @@ class ChannelIsolator
      */
     cv::Mat invert_image(const cv::Mat& img);
 
+    /**
+     * Constrói a tabela de inversão (table[v] = 255 - v) usada por invert_image,
+     * para composição com outras operações pontuais.
+     * @return Tabela de inversão
+     */
+    PointLut invert_lut();
+
     private:
         /**
          * Valida se a imagem é colorida (3 canais) e não está vazia.
@@ -140,6 +196,9 @@ class ChannelIsolator
      * @return true se compatíveis, false caso contrário
      */
     bool are_channels_compatible(const cv::Mat& img1, const cv::Mat& img2, const cv::Mat& img3);
+
+    // Planos CV_8UC1 disponíveis para reutilização (procurados por tamanho).
+    BufferPool pool_;
 };
 
 #endif // CHANNEL_ISOLATOR_HPP
@@ -0,0 +1,99 @@
+#ifndef COLOR_CONVERTER_HPP
+#define COLOR_CONVERTER_HPP
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * Classe ColorConverter
+ * ---------------------
+ * Conversão de imagens BGR (CV_8UC3) para os espaços YCbCr, HSV e CIE Lab
+ * e de volta, com a mesma codificação de 8 bits do OpenCV (cv::cvtColor):
+ * - YCrCb: canais na ordem Y, Cr, Cb (cv::COLOR_BGR2YCrCb)
+ * - HSV: H em [0, 180) (graus / 2), S e V em [0, 255] (cv::COLOR_BGR2HSV)
+ * - Lab: L * 255 / 100, a + 128, b + 128, iluminante D65 (cv::COLOR_BGR2Lab)
+ *
+ * Implementação:
+ * - YCrCb em ponto fixo Q14 (coeficientes do OpenCV), vetorizado com
+ *   SSSE3 (pmaddwd) e separação/junção BGR por pshufb
+ * - HSV por tabelas de divisão (BGR -> HSV) e de setor/fração do matiz
+ *   (HSV -> BGR)
+ * - Lab por tabelas de linearização sRGB e de raiz cúbica (interpolada);
+ *   o retorno usa uma tabela de 64 KB de luz linear para sRGB
+ * - Todas as conversões dividem as linhas entre threads (cv::parallel_for_)
+ *
+ * Uso típico:
+ *   ColorConverter converter{};
+ *   cv::Mat hsv = converter.bgr_to_hsv(bgr_img);
+ *   cv::Mat back = converter.hsv_to_bgr(hsv);
+ */
+class ColorConverter
+{
+    public:
+        /**
+         * Construtor padrão.
+         */
+    ColorConverter();
+
+    /**
+     * Destrutor.
+     */
+    ~ColorConverter();
+
+    // ================ YCbCr ================
+
+    /**
+     * Converte BGR para YCrCb (Y = 0.299R + 0.587G + 0.114B,
+     * Cr = 0.713(R - Y) + 128, Cb = 0.564(B - Y) + 128).
+     * Resultado idêntico ao de cv::cvtColor(..., cv::COLOR_BGR2YCrCb).
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @return Imagem CV_8UC3 com canais Y, Cr, Cb (vazia se inválida)
+     */
+    cv::Mat bgr_to_ycrcb(const cv::Mat& img);
+
+    /**
+     * Converte YCrCb (canais Y, Cr, Cb) de volta para BGR.
+     * @param img Imagem YCrCb (CV_8UC3)
+     * @return Imagem BGR (CV_8UC3; vazia se inválida)
+     */
+    cv::Mat ycrcb_to_bgr(const cv::Mat& img);
+
+    // ================ HSV ================
+
+    /**
+     * Converte BGR para HSV (H em [0, 180), S e V em [0, 255]).
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @return Imagem HSV (CV_8UC3; vazia se inválida)
+     */
+    cv::Mat bgr_to_hsv(const cv::Mat& img);
+
+    /**
+     * Converte HSV (H em [0, 180)) de volta para BGR.
+     * @param img Imagem HSV (CV_8UC3)
+     * @return Imagem BGR (CV_8UC3; vazia se inválida)
+     */
+    cv::Mat hsv_to_bgr(const cv::Mat& img);
+
+    // ================ CIE Lab ================
+
+    /**
+     * Converte BGR (sRGB) para CIE Lab (D65) codificado em 8 bits.
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @return Imagem Lab (CV_8UC3; vazia se inválida)
+     */
+    cv::Mat bgr_to_lab(const cv::Mat& img);
+
+    /**
+     * Converte CIE Lab (8 bits) de volta para BGR (sRGB).
+     * @param img Imagem Lab (CV_8UC3)
+     * @return Imagem BGR (CV_8UC3; vazia se inválida)
+     */
+    cv::Mat lab_to_bgr(const cv::Mat& img);
+
+    private:
+        /**
+         * Verifica se a imagem tem 3 canais de 8 bits.
+         */
+    bool is_valid_image(const cv::Mat& img);
+};
+
+#endif // COLOR_CONVERTER_HPP
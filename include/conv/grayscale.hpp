@@ -1,6 +1,8 @@
 #ifndef OPERATION_HPP
 #define OPERATION_HPP
 #include <opencv2/opencv.hpp>
+#include "conv/buffer_pool.hpp"
+#include <vector>
 /**
  * Classe GrayScale
  * ----------------
@@ -12,10 +14,25 @@
  *   cv::Mat gray_arithmetic = gs.get_gray_arithmetic();
  *   cv::Mat gray_weighted = gs.get_gray_weighted();
  *
+ * Uso em sequência de quadros (sem alocação após o primeiro quadro):
+ *   GrayScale converter{};
+ *   cv::Mat gray;
+ *   while (capture.read(frame))
+ *   {
+ *       converter.convert(frame, gray);
+ *   }
+ *
  * Notas:
  * - Não faz cópia profunda da imagem de entrada no construtor; armazena a
  *   referência matricial (cv::Mat) internamente.
+ * - Cada chamada a get_gray_* devolve uma imagem nova (chamadas sucessivas
+ *   não compartilham o buffer de saída).
  * - Oferece dois métodos de conversão: média aritmética simples e média ponderada.
+ * - As conversões usam aritmética inteira (ponto fixo) e, quando disponível,
+ *   SSSE3/AVX2 com separação dos canais BGR por pshufb.
+ * - convert_pooled, acquire_buffer, recycle_buffer e release_buffers alteram
+ *   o conjunto interno de buffers (BufferPool) e não são thread-safe: não
+ *   compartilhe a mesma instância entre threads nessas chamadas.
  */
 
 class GrayScale
@@ -23,26 +40,84 @@ class GrayScale
 	public:
 
 		/**
-			* Constrói o conversor a partir de uma imagem BGR válida.
+			* Coeficientes de luminância da média ponderada.
+			* Ambos em ponto fixo Q15 (soma 32768):
+			* - BT601: 0.114*B + 0.587*G + 0.299*R  -> (3735, 19235, 9798)
+			* - BT709: 0.0722*B + 0.7152*G + 0.2126*R -> (2366, 23436, 6966)
+			*/
+	enum GrayStandard
+	{
+		BT601,   // ITU-R BT.601 (padrão; mesmos pesos de cv::COLOR_BGR2GRAY)
+		BT709    // ITU-R BT.709 (HDTV / sRGB)
+	};
+
+	/**
+		* Método de conversão para as chamadas com entrada/saída explícitas.
+		*/
+	enum GrayMethod
+	{
+		ARITHMETIC,   // (B + G + R) / 3
+		WEIGHTED,     // Média ponderada (ver GrayStandard)
+		LINEAR        // Média ponderada em luz linear (sRGB decodificado)
+	};
+
+	/**
+		* Constrói um conversor sem imagem associada, para uso com convert,
+		* convert_rows e convert_pooled.
+		*/
+	GrayScale();
+
+	/**
+		* Constrói o conversor a partir de uma imagem BGR válida.
 			* Pré-condição: img1 não deve estar vazia (img1.empty() == false).
 			*/
 	GrayScale(const cv::Mat& img1);
 
 	/**
 		* Realiza a conversão para escala de cinza por média simples dos canais.
-		* Fórmula: gray = (B + G + R) / 3
+		* Fórmula: gray = (B + G + R) / 3 (divisão inteira, truncada)
+		* Calculada como ((B + G + R) * 21846) >> 16, idêntica à divisão para
+		* todas as somas possíveis (0..765).
 		* Retorna: matriz CV_8UC1, mesmo tamanho da imagem de entrada.
 		* Custo: O(H×W), varrendo a imagem linha a linha.
 		*/
 	cv::Mat get_gray_arithmetic();
 
 	/**
-		* Realiza a conversão para escala de cinza por média ponderada (padrão ITU-R BT.709).
-		* Fórmula: gray = 0.114*B + 0.587*G + 0.299*R
+		* Realiza a conversão para escala de cinza por média ponderada.
+		* Fórmula (BT.601): gray = 0.114*B + 0.587*G + 0.299*R
+		* Arredondamento de referência (igual ao do OpenCV):
+		*   gray = (wB*B + wG*G + wR*R + 16384) >> 15, com pesos Q15
+		* isto é, o valor exato dos pesos Q15 arredondado para o inteiro mais
+		* próximo (metades para cima).
+		* @param standard Coeficientes (BT601 ou BT709; padrão: BT601)
 		* Retorna: matriz CV_8UC1, mesmo tamanho da imagem de entrada.
 		* Custo: O(H×W), varrendo a imagem linha a linha.
 		*/
-	cv::Mat get_gray_weighted();
+	cv::Mat get_gray_weighted(GrayStandard standard = BT601);
+
+	/**
+		* Conversão ponderada em luz linear (gamma correta): os canais sRGB são
+		* decodificados para intensidade linear de 16 bits por tabela, ponderados
+		* e o resultado é recodificado para sRGB.
+		* Fórmula: gray = sRGB(wB*lin(B) + wG*lin(G) + wR*lin(R))
+		* Preserva a luminância fotométrica (cinzas puros não mudam; cores
+		* saturadas ficam mais claras que em get_gray_weighted).
+		* @param standard Coeficientes (padrão: BT709, primárias do sRGB)
+		* Retorna: matriz CV_8UC1, mesmo tamanho da imagem de entrada.
+		* Custo: O(H×W), com tabelas de 1 KB e 64 KB (gather no AVX2).
+		*/
+	cv::Mat get_gray_linear(GrayStandard standard = BT709);
+
+	/**
+		* Conversão ponderada (mesma fórmula de get_gray_weighted) que acumula,
+		* na mesma passada, o histograma de 256 níveis da imagem resultante.
+		* Evita reler a imagem cinza para limiarização automática (Otsu/triângulo).
+		* @param histogram Saída: vetor com 256 contagens (redimensionado e zerado)
+		* @param standard Coeficientes (BT601 ou BT709; padrão: BT601)
+		* Retorna: matriz CV_8UC1, mesmo tamanho da imagem de entrada.
+		*/
+	cv::Mat get_gray_weighted_histogram(std::vector<int>& histogram, GrayStandard standard = BT601);
 
 	/**
 		* Mantém compatibilidade com código anterior (chama get_gray_arithmetic).
@@ -50,11 +125,102 @@ class GrayScale
 		*/
 	cv::Mat get_gray();
 
+	/**
+		* Converte uma imagem BGR para tons de cinza em um buffer do chamador.
+		* output só é (re)alocado se não for CV_8UC1 do mesmo tamanho da
+		* entrada, então reutilizá-lo entre quadros evita alocações.
+		* @param input Imagem de entrada (CV_8UC3 BGR)
+		* @param output Saída (CV_8UC1, mesmo tamanho da entrada)
+		* @param method Método (ARITHMETIC ou WEIGHTED; padrão: WEIGHTED)
+		* @param standard Coeficientes da média ponderada (padrão: BT601)
+		* Retorna: true se convertido, false se a entrada for inválida.
+		*/
+	bool convert(const cv::Mat& input, cv::Mat& output, GrayMethod method = WEIGHTED, GrayStandard standard = BT601);
+
+	/**
+		* Converte apenas as linhas [row_begin, row_end); as demais linhas de
+		* output não são alteradas (útil para faixas paralelas ou regiões
+		* atualizadas). output é alocado como em convert se necessário.
+		* @param input Imagem de entrada (CV_8UC3 BGR)
+		* @param output Saída (CV_8UC1, mesmo tamanho da entrada)
+		* @param row_begin Primeira linha (inclusive)
+		* @param row_end Última linha (exclusive)
+		* @param method Método (ARITHMETIC ou WEIGHTED; padrão: WEIGHTED)
+		* @param standard Coeficientes da média ponderada (padrão: BT601)
+		* Retorna: true se convertido, false se a entrada for inválida.
+		*/
+	bool convert_rows(const cv::Mat& input, cv::Mat& output, int row_begin, int row_end,
+	                  GrayMethod method = WEIGHTED, GrayStandard standard = BT601);
+
+	/**
+		* Limiarização binária fundida com a conversão ponderada: o nível de
+		* cinza de cada bloco de pixels fica em registradores e vira a máscara
+		* direto, sem gravar nem reler uma imagem cinza intermediária.
+		* Equivale a binary_threshold(get_gray_weighted(), ...), em faixas de
+		* linhas paralelas.
+		* @param input Imagem de entrada (CV_8UC3 BGR)
+		* @param mask Saída: CV_8UC1, gray > threshold_value -> max_value, senão 0
+		* @param threshold_value Limiar
+		* @param max_value Valor atribuído aos pixels acima do limiar
+		* @param inverted true inverte a máscara (gray > limiar -> 0)
+		* @param standard Coeficientes da média ponderada (padrão: BT601)
+		* Retorna: true se convertido, false se a entrada for inválida.
+		*/
+	bool threshold_weighted(const cv::Mat& input, cv::Mat& mask, uchar threshold_value, uchar max_value = 255,
+	                        bool inverted = false, GrayStandard standard = BT601);
+
+	/**
+		* Como threshold_weighted, acumulando também o histograma de 256 níveis
+		* do cinza na mesma passada.
+		* @param histogram Saída: vetor com 256 contagens
+		*/
+	bool threshold_weighted(const cv::Mat& input, cv::Mat& mask, std::vector<int>& histogram,
+	                        uchar threshold_value, uchar max_value = 255, bool inverted = false,
+	                        GrayStandard standard = BT601);
+
+	/**
+		* Histograma de 256 níveis do cinza ponderado sem gerar a imagem cinza
+		* (apenas lê a entrada BGR), em faixas de linhas paralelas.
+		* @param input Imagem de entrada (CV_8UC3 BGR)
+		* @param histogram Saída: vetor com 256 contagens
+		* @param standard Coeficientes da média ponderada (padrão: BT601)
+		* Retorna: true se calculado, false se a entrada for inválida.
+		*/
+	bool histogram_weighted(const cv::Mat& input, std::vector<int>& histogram, GrayStandard standard = BT601);
+
+	/**
+		* Converte para um buffer retirado do conjunto interno (por tamanho).
+		* Devolva o buffer com recycle_buffer quando não for mais usado.
+		* @param input Imagem de entrada (CV_8UC3 BGR)
+		* @param method Método (ARITHMETIC ou WEIGHTED; padrão: WEIGHTED)
+		* @param standard Coeficientes da média ponderada (padrão: BT601)
+		* Retorna: imagem CV_8UC1 (vazia se a entrada for inválida).
+		*/
+	cv::Mat convert_pooled(const cv::Mat& input, GrayMethod method = WEIGHTED, GrayStandard standard = BT601);
+
+	/**
+		* Retira do conjunto um buffer CV_8UC1 do tamanho pedido (ou aloca um).
+		* @param size Tamanho do buffer
+		* Retorna: buffer CV_8UC1 com conteúdo indefinido.
+		*/
+	cv::Mat acquire_buffer(cv::Size size);
+
+	/**
+		* Devolve um buffer ao conjunto para reutilização; buffer fica vazio.
+		* @param buffer Buffer obtido de acquire_buffer ou convert_pooled
+		*/
+	void recycle_buffer(cv::Mat& buffer);
+
+	/**
+		* Libera todos os buffers guardados no conjunto.
+		*/
+	void release_buffers();
+
 	private:
 		// Armazena a imagem de entrada (espera-se tipo CV_8UC3 em BGR).
 	cv::Mat img1_;
-	// Buffer de saída (CV_8UC1). É inicializado no construtor.
-	cv::Mat result;
+	// Buffers CV_8UC1 disponíveis para reutilização (procurados por tamanho).
+	BufferPool pool_;
 
 };
 #endif  // OPERATION_HPP
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef SRGB_TABLES_HPP
+#define SRGB_TABLES_HPP
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Tabelas internas sRGB <-> luz linear (IEC 61966-2-1)
+ * ------------------------------------------------------
+ * Compartilhadas pelas conversões do módulo conv que trabalham em luz
+ * linear (GrayScale::get_gray_linear e o Lab do ColorConverter). São
+ * construídas uma única vez, no primeiro uso (inicialização thread-safe de
+ * variável estática local).
+ * - decode: byte sRGB -> intensidade linear em 16 bits (0..65535), guardada
+ *           em 32 bits para servir direto ao gather do AVX2
+ * - linear: byte sRGB -> intensidade linear em ponto flutuante [0, 1]
+ * - encode: intensidade linear de 16 bits -> byte sRGB arredondado ao mais
+ *           próximo; 3 bytes extras permitem o gather de 32 bits com escala 1
+ */
+namespace srgb
+{
+    /**
+     * Converte um valor sRGB normalizado [0, 1] para luz linear [0, 1].
+     */
+    inline double to_linear(double c)
+    {
+        return (c <= 0.04045) ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    struct Tables
+    {
+        uint32_t decode[256];
+        float linear[256];
+        uint8_t encode[65536 + 3];
+
+        Tables()
+        {
+            for (int v = 0; v < 256; v++)
+            {
+                const double value = to_linear(v / 255.0);
+                decode[v] = static_cast<uint32_t>(std::lround(65535.0 * value));
+                linear[v] = static_cast<float>(value);
+            }
+
+            // encode[y] = k para y no intervalo cujo valor sRGB arredonda para k:
+            // limites nos pontos médios (k + 0.5) / 255 convertidos para linear
+            int y = 0;
+            for (int k = 0; k < 255; k++)
+            {
+                const int upper = static_cast<int>(std::ceil(65535.0 * to_linear((k + 0.5) / 255.0)));
+                for (; y < upper; y++)
+                {
+                    encode[y] = static_cast<uint8_t>(k);
+                }
+            }
+            for (; y < 65536 + 3; y++)
+            {
+                encode[y] = 255;
+            }
+        }
+    };
+
+    /**
+     * Instância única das tabelas (construída no primeiro uso).
+     */
+    inline const Tables& tables()
+    {
+        static const Tables instance;
+        return instance;
+    }
+}
+
+#endif // SRGB_TABLES_HPP
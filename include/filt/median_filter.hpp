@@ -0,0 +1,65 @@
+#ifndef MEDIAN_FILTER_HPP
+#define MEDIAN_FILTER_HPP
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * Classe MedianFilter
+ * -------------------
+ * Filtro de mediana para remoção de ruído impulsivo (sal e pimenta) em
+ * imagens CV_8UC1 e CV_8UC3 (cada canal filtrado independentemente).
+ * Janela quadrada de lado 2 * radius + 1; bordas replicadas.
+ *
+ * Algoritmo:
+ * - Raio 1 (3x3): rede de ordenação de 19 comparações (min/max), vetorizada
+ * - Raio >= 2: histogramas deslizantes de coluna (Perreault/Hébert), com
+ *   256 bins indexados pela intensidade (mesmo layout de
+ *   HistogramProcessor::compute_histogram_gray) e 16 bins grossos; o custo
+ *   por pixel não depende do raio
+ * - Modo multithread: a imagem é dividida em faixas de linhas, cada uma com
+ *   seus próprios histogramas de coluna
+ *
+ * Uso típico:
+ *   MedianFilter median{};
+ *   cv::Mat clean = median.median_filter(noisy, 5);
+ */
+class MedianFilter
+{
+    public:
+        /**
+         * Raio máximo aceito (contadores de 16 bits: (2r + 1)^2 < 65536).
+         */
+    static constexpr int MAX_RADIUS = 127;
+
+    /**
+     * Construtor padrão.
+     */
+    MedianFilter();
+
+    /**
+     * Destrutor.
+     */
+    ~MedianFilter();
+
+    /**
+     * Aplica o filtro de mediana.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3)
+     * @param radius Raio da janela (1 a MAX_RADIUS; janela (2r + 1) x (2r + 1))
+     * @param multithreaded true para dividir as linhas entre threads (padrão)
+     * @return Imagem filtrada (mesmo tipo da entrada)
+     */
+    cv::Mat median_filter(const cv::Mat& img, int radius, bool multithreaded = true);
+
+    private:
+        /**
+         * Rede de ordenação 3x3 para as linhas [row_begin, row_end).
+         */
+    void median_3x3(const cv::Mat& img, cv::Mat& result, int row_begin, int row_end);
+
+    /**
+     * Histogramas deslizantes para as linhas [row_begin, row_end).
+     */
+    void median_histogram(const cv::Mat& img, cv::Mat& result, int radius, int row_begin, int row_end);
+};
+
+#endif // MEDIAN_FILTER_HPP
@@ -2,6 +2,8 @@
 #define HISTOGRAM_HPP
 
 #include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -11,11 +13,19 @@
  * coloridas (BGR) e em tons de cinza.
  *
  * Funcionalidades:
- * - Cálculo de histograma para imagens em tons de cinza
+ * - Cálculo de histograma para imagens em tons de cinza (também multithread)
+ * - Histogramas aproximados por amostragem, com limite de erro estatístico
  * - Cálculo de histograma para cada canal (B, G, R) de imagens coloridas
- * - Visualização gráfica dos histogramas
+ *   em uma única passada, com contadores de 64 bits sem alocação
+ * - Visualização gráfica dos histogramas (qualquer largura, escala log,
+ *   canais sobrepostos, desenho em buffer fornecido pelo chamador)
  * - Normalização de histogramas
+ * - Equalização global e adaptativa com limite de contraste (CLAHE)
+ * - Especificação (casamento) de histograma com uma referência
+ * - Comparação de histogramas (qui-quadrado, interseção, Bhattacharyya, EMD)
  * - Estatísticas básicas (mínimo, máximo, média)
+ * - Estatísticas de intensidade a partir do histograma (média, variância,
+ *   percentis, entropia) e redução direta por canal sobre a imagem
  *
  * Uso típico:
  *   HistogramProcessor hist_proc{};
@@ -26,8 +36,19 @@ class HistogramProcessor
 {
     public:
         /**
-         * Estrutura para armazenar histogramas de imagem colorida.
+         * Métricas de comparação de histogramas.
          */
+    enum CompareMethod
+    {
+        COMPARE_CHI_SQUARE,      // sum (p - q)^2 / (p + q)         0 = iguais
+        COMPARE_INTERSECTION,    // sum min(p, q)                   1 = iguais
+        COMPARE_BHATTACHARYYA,   // sqrt(1 - sum sqrt(p * q))       0 = iguais
+        COMPARE_EMD              // sum |CDF_p - CDF_q| (em bins)   0 = iguais
+    };
+
+    /**
+     * Estrutura para armazenar histogramas de imagem colorida.
+     */
     struct ColorHistogram
     {
         std::vector<int> blue_hist;   // Histograma do canal azul
@@ -35,6 +56,61 @@ class HistogramProcessor
         std::vector<int> red_hist;    // Histograma do canal vermelho
     };
 
+    /**
+     * Histograma de tamanho fixo com contadores de 64 bits (não estoura
+     * em imagens com mais de 2^31 pixels e não aloca memória).
+     */
+    typedef std::array<uint64_t, 256> HistogramCounts;
+
+    /**
+     * Histogramas dos três canais em contadores de 64 bits.
+     */
+    struct ColorHistogramCounts
+    {
+        HistogramCounts blue;   // Histograma do canal azul
+        HistogramCounts green;  // Histograma do canal verde
+        HistogramCounts red;    // Histograma do canal vermelho
+    };
+
+    /**
+     * Distribuições acumuladas normalizadas de uma referência, calculadas
+     * uma única vez e reutilizadas para casar vários quadros com ela.
+     */
+    struct ReferenceCdf
+    {
+        int channels;                                   // 1 (cinza), 3 (BGR) ou 0 (inválida)
+        std::array<std::array<double, 256>, 3> cdf;     // cdf[canal][nível] em [0, 1]
+    };
+
+    /**
+     * Estatísticas das intensidades de uma imagem, derivadas do histograma.
+     */
+    struct IntensityStats
+    {
+        uint64_t count;     // Número de pixels (0 se o histograma for inválido)
+        int min;            // Menor intensidade presente
+        int max;            // Maior intensidade presente
+        double mean;        // Média das intensidades
+        double variance;    // Variância populacional
+        double stddev;      // Desvio padrão
+        int median;         // Percentil 50
+        double entropy;     // Entropia de Shannon, em bits
+    };
+
+    /**
+     * Momentos por canal calculados diretamente sobre a imagem.
+     * Apenas os primeiros `channels` elementos de cada array são válidos.
+     */
+    struct ChannelStats
+    {
+        int channels;                           // 1 ou 3 (0 se a imagem for inválida)
+        uint64_t count;                         // Pixels por canal
+        std::array<int, 3> min;                 // Menor valor de cada canal
+        std::array<int, 3> max;                 // Maior valor de cada canal
+        std::array<uint64_t, 3> sum;            // Soma dos valores
+        std::array<uint64_t, 3> sum_squares;    // Soma dos quadrados
+    };
+
     /**
      * Construtor padrão.
      */
@@ -54,21 +130,141 @@ class HistogramProcessor
      */
     std::vector<int> compute_histogram_gray(const cv::Mat& img);
 
+    /**
+     * Calcula histograma de imagem em tons de cinza usando várias threads.
+     * Cada thread processa uma faixa de linhas em 4 sub-histogramas
+     * intercalados (quebra a dependência de leitura/escrita quando pixels
+     * vizinhos repetem o valor) e os resultados são somados no final.
+     * Resultado idêntico ao de compute_histogram_gray.
+     * @param img Imagem em tons de cinza (CV_8UC1)
+     * @return Vetor com 256 elementos contendo a frequência de cada intensidade
+     */
+    std::vector<int> compute_histogram_gray_parallel(const cv::Mat& img);
+
+    /**
+     * Histograma do cinza ponderado (BT.601) de uma imagem BGR sem gerar a
+     * imagem cinza: a conversão e a contagem são fundidas em uma passada
+     * paralela (GrayScale::histogram_weighted), que só lê a entrada.
+     * Equivale a compute_histogram_gray(get_gray_weighted()).
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @return Vetor com 256 elementos (vazio se a imagem for inválida)
+     */
+    std::vector<int> compute_histogram_luma(const cv::Mat& img);
+
+    /**
+     * Histograma aproximado por amostragem: usa uma a cada `stride` linhas e,
+     * nelas, uma a cada `stride` colunas (com deslocamento pseudoaleatório por
+     * linha, para não coincidir com padrões periódicos). As contagens são
+     * escaladas para o total de pixels. Custo ~ 1 / stride^2 do exato.
+     * Limite de erro (Dvoretzky-Kiefer-Wolfowitz, 95% de confiança, supondo
+     * amostras independentes): |F_aprox - F| <= error_bound para a
+     * distribuição acumulada, e <= 2 * error_bound para a fração de cada bin.
+     * @param img Imagem em tons de cinza (CV_8UC1)
+     * @param stride Passo de amostragem (1 = exato)
+     * @param error_bound Saída: limite de erro, como fração do total de pixels
+     * @return Vetor com 256 elementos (contagens estimadas)
+     */
+    std::vector<int> compute_histogram_gray_approx(const cv::Mat& img, int stride, double& error_bound);
+
+    /**
+     * Histogramas aproximados dos três canais (mesma amostragem e mesmo
+     * limite de erro de compute_histogram_gray_approx, por canal).
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @param stride Passo de amostragem (1 = exato)
+     * @param error_bound Saída: limite de erro, como fração do total de pixels
+     * @return Estrutura ColorHistogram com as contagens estimadas
+     */
+    ColorHistogram compute_histogram_color_approx(const cv::Mat& img, int stride, double& error_bound);
+
     /**
      * Calcula histogramas dos três canais de imagem colorida.
+     * Adaptador sobre compute_histogram_color_counts (mesma passada única).
      * @param img Imagem colorida (CV_8UC3 BGR)
      * @return Estrutura ColorHistogram com histogramas dos canais B, G, R
      */
     ColorHistogram compute_histogram_color(const cv::Mat& img);
 
+    /**
+     * Calcula histogramas dos três canais em uma única passada, sem alocação.
+     * Os pixels são contados em sub-histogramas de 32 bits intercalados
+     * (pixels pares e ímpares em tabelas distintas), descarregados nos
+     * contadores de 64 bits antes de poderem estourar.
+     * @param img Imagem colorida (CV_8UC3 BGR)
+     * @param counts Saída: histogramas dos canais B, G, R (sobrescritos)
+     * @return true se a imagem for válida, false caso contrário
+     */
+    bool compute_histogram_color_counts(const cv::Mat& img, ColorHistogramCounts& counts);
+
     /**
      * Calcula histograma de um canal específico de imagem colorida.
+     * Adaptador sobre compute_histogram_color_counts; para vários canais,
+     * prefira a chamada única a compute_histogram_color_counts.
      * @param img Imagem colorida (CV_8UC3 BGR)
      * @param channel Índice do canal (0=B, 1=G, 2=R)
      * @return Vetor com 256 elementos contendo a frequência de cada intensidade do canal
      */
     std::vector<int> compute_histogram_channel(const cv::Mat& img, int channel);
 
+    // ================ Equalização ================
+
+    /**
+     * Equalização global de histograma: remapeia as intensidades pela
+     * distribuição acumulada (aplicada como tabela de consulta).
+     * Em imagens coloridas cada canal é equalizado independentemente.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3)
+     * @return Imagem equalizada (mesmo tipo da entrada)
+     */
+    cv::Mat equalize_histogram(const cv::Mat& img);
+
+    /**
+     * Equalização adaptativa com limite de contraste (CLAHE).
+     * A imagem é dividida em uma grade de blocos; o histograma de cada bloco
+     * é calculado em paralelo, cortado em clip_limit e convertido em uma
+     * tabela de equalização. Cada pixel recebe a interpolação bilinear das
+     * tabelas dos 4 blocos mais próximos (aritmética inteira, vetorizada).
+     * @param img Imagem em tons de cinza (CV_8UC1)
+     * @param clip_limit Limite de contraste relativo à altura média do
+     *                   histograma do bloco (padrão: 40; <= 0 desativa o corte)
+     * @param tile_grid Número de blocos em x e y (padrão: 8x8)
+     * @return Imagem equalizada (CV_8UC1)
+     */
+    cv::Mat equalize_clahe(const cv::Mat& img, double clip_limit = 40.0, cv::Size tile_grid = cv::Size(8, 8));
+
+    // ================ Especificação de histograma ================
+
+    /**
+     * Calcula as CDFs de uma imagem de referência (uma passada de histograma).
+     * @param reference Imagem de referência (CV_8UC1 ou CV_8UC3)
+     * @return CDFs por canal (channels == 0 se a imagem for inválida)
+     */
+    ReferenceCdf build_reference_cdf(const cv::Mat& reference);
+
+    /**
+     * Calcula a CDF de um histograma de referência em tons de cinza.
+     * @param histogram Histograma de referência (256 elementos)
+     * @return CDF de um canal (channels == 0 se o histograma for inválido)
+     */
+    ReferenceCdf build_reference_cdf(const std::vector<int>& histogram);
+
+    /**
+     * Remapeia a imagem para que seu histograma se aproxime do da referência:
+     * cada nível i vai para o menor nível j com CDF_ref(j) >= CDF_img(i).
+     * A tabela é montada em O(256) por canal e aplicada com PointLut.
+     * @param img Imagem de entrada (mesmo número de canais da referência)
+     * @param reference CDFs da referência (ver build_reference_cdf)
+     * @return Imagem com histograma especificado (mesmo tipo da entrada)
+     */
+    cv::Mat match_histogram(const cv::Mat& img, const ReferenceCdf& reference);
+
+    /**
+     * Atalho para casar com uma imagem de referência; para vários quadros,
+     * calcule a referência uma vez com build_reference_cdf.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3)
+     * @param reference Imagem de referência (mesmo número de canais)
+     * @return Imagem com histograma especificado (mesmo tipo da entrada)
+     */
+    cv::Mat match_histogram(const cv::Mat& img, const cv::Mat& reference);
+
     // ================ Visualização de histogramas ================
 
     /**
@@ -99,6 +295,31 @@ class HistogramProcessor
      */
     cv::Mat visualize_histogram(const std::vector<int>& histogram, int hist_height, int hist_width, cv::Scalar color);
 
+    /**
+     * Desenha um ou mais histogramas sobrepostos diretamente em um buffer
+     * existente. Os histogramas são lidos por ponteiro (sem cópia) e a área
+     * auxiliar por coluna é um membro reutilizado entre chamadas, então o
+     * redesenho a cada quadro não aloca depois da primeira chamada (ou de um
+     * aumento da largura ou do número de histogramas); release_render_buffer
+     * a libera. Não compartilhe a mesma instância entre threads nesta chamada.
+     * Cada coluna da saída cobre a faixa de bins [x*256/w, (x+1)*256/w) e usa
+     * o maior valor da faixa, então qualquer largura é aproveitada. As cores
+     * de histogramas sobrepostos são somadas com saturação.
+     * @param histograms Ponteiros para os histogramas (256 elementos cada),
+     *                   na mesma escala
+     * @param colors Cor (BGR) de cada histograma
+     * @param canvas Buffer de saída (CV_8UC3 já alocado; define altura e largura)
+     * @param log_scale true para alturas proporcionais a log(1 + contagem)
+     * @return true se desenhado, false se a entrada for inválida
+     */
+    bool render_histograms(const std::vector<const std::vector<int>*>& histograms, const std::vector<cv::Scalar>& colors,
+                           cv::Mat& canvas, bool log_scale = false);
+
+    /**
+     * Libera a área auxiliar usada por render_histograms.
+     */
+    void release_render_buffer();
+
     // ================ Operações auxiliares ================
 
     /**
@@ -125,6 +346,48 @@ class HistogramProcessor
      */
     int find_histogram_max(const std::vector<int>& histogram);
 
+    // ================ Comparação de histogramas ================
+
+    /**
+     * Compara dois histogramas do mesmo tamanho (ex.: saídas de
+     * compute_histogram_gray ou compute_histogram_channel). Ambos são
+     * normalizados para soma 1 antes da comparação, então imagens de
+     * tamanhos diferentes podem ser comparadas.
+     * @param hist_a Primeiro histograma
+     * @param hist_b Segundo histograma (mesmo número de bins)
+     * @param method Métrica (ver CompareMethod)
+     * @return Valor da métrica (-1 se a entrada for inválida)
+     */
+    double compare_histograms(const std::vector<int>& hist_a, const std::vector<int>& hist_b, CompareMethod method);
+
+    // ================ Estatísticas de intensidade ================
+
+    /**
+     * Estatísticas das intensidades a partir de um histograma, em O(256).
+     * Diferente de compute_histogram_stats, que descreve as contagens dos bins.
+     * @param histogram Histograma de intensidades (256 elementos)
+     * @return Estatísticas (count == 0 se o histograma for inválido ou vazio)
+     */
+    IntensityStats compute_intensity_stats(const std::vector<int>& histogram);
+
+    /**
+     * Percentil das intensidades a partir de um histograma: menor nível cuja
+     * frequência acumulada atinge percentile% do total.
+     * @param histogram Histograma de intensidades (256 elementos)
+     * @param percentile Percentil em [0, 100]
+     * @return Nível de intensidade (-1 se a entrada for inválida)
+     */
+    int compute_percentile(const std::vector<int>& histogram, double percentile);
+
+    /**
+     * Mínimo, máximo, soma e soma dos quadrados de cada canal em uma única
+     * passada sobre a imagem, sem histograma (vetorizado com AVX2).
+     * @param img Imagem (CV_8UC1 ou CV_8UC3)
+     * @param stats Saída: momentos por canal
+     * @return true se a imagem for válida, false caso contrário
+     */
+    bool compute_channel_stats(const cv::Mat& img, ChannelStats& stats);
+
     private:
         /**
          * Valida se a imagem é adequada para processamento de histograma.
@@ -133,6 +396,9 @@ class HistogramProcessor
          * @return true se válida, false caso contrário
          */
     bool is_valid_image(const cv::Mat& img, int expected_channels);
+
+    // Topo das barras por coluna e histograma (render_histograms; só cresce).
+    std::vector<int> render_scratch_;
 };
 
 #endif // HISTOGRAM_HPP
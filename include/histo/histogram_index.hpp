@@ -0,0 +1,143 @@
+#ifndef HISTOGRAM_INDEX_HPP
+#define HISTOGRAM_INDEX_HPP
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Classe HistogramIndex
+ * ---------------------
+ * Índice em memória de assinaturas de cor para busca de imagens parecidas
+ * ou quase duplicadas (k vizinhos mais próximos).
+ *
+ * Assinatura:
+ * - Histograma conjunto BGR quantizado em 4 níveis por canal (64 bins)
+ * - Cada bin guarda a fração de pixels em ponto fixo de 16 bits
+ *   (soma ~= SIGNATURE_SCALE): 128 bytes por imagem
+ * - Imagens em tons de cinza usam o mesmo nível nos três canais
+ *
+ * Busca:
+ * - Distância L1 entre assinaturas (equivale a 2 * (1 - interseção) dos
+ *   histogramas normalizados, na escala SIGNATURE_SCALE), vetorizada com AVX2
+ * - Varredura dividida entre threads; cada faixa mantém seus k melhores
+ *
+ * Persistência:
+ * - Arquivo binário: "PDIH", versão, bins, quantidade e assinaturas na
+ *   ordem de bytes nativa da máquina (não portável entre little- e
+ *   big-endian), carregado de volta com uma única leitura
+ * - load valida a quantidade contra o tamanho do arquivo antes de alocar
+ *
+ * Uso típico:
+ *   HistogramIndex index{};
+ *   for (const cv::Mat& frame : frames) index.add(frame);
+ *   index.save("archive.idx");
+ *   std::vector<HistogramIndex::Match> similar = index.query(new_frame, 5);
+ */
+class HistogramIndex
+{
+    public:
+        /**
+         * Número de bins da assinatura (4 x 4 x 4).
+         */
+    static constexpr int BINS = 64;
+
+    /**
+     * Soma das frações de uma assinatura (cabe em int16 com sinal).
+     */
+    static constexpr int SIGNATURE_SCALE = 32767;
+
+    /**
+     * Histograma de cor quantizado de uma imagem.
+     */
+    typedef std::array<uint16_t, BINS> Signature;
+
+    /**
+     * Resultado de uma consulta.
+     */
+    struct Match
+    {
+        int id;             // Índice da imagem (ordem de inserção)
+        uint32_t distance;  // Distância L1 entre assinaturas
+    };
+
+    /**
+     * Construtor padrão (índice vazio).
+     */
+    HistogramIndex();
+
+    /**
+     * Destrutor.
+     */
+    ~HistogramIndex();
+
+    /**
+     * Calcula a assinatura de uma imagem em uma passada.
+     * @param img Imagem (CV_8UC1 ou CV_8UC3 BGR)
+     * @param signature Saída: assinatura
+     * @return true se a imagem for válida, false caso contrário
+     */
+    bool compute_signature(const cv::Mat& img, Signature& signature) const;
+
+    /**
+     * Adiciona uma imagem ao índice.
+     * @param img Imagem (CV_8UC1 ou CV_8UC3 BGR)
+     * @return Identificador da imagem (-1 se a imagem for inválida)
+     */
+    int add(const cv::Mat& img);
+
+    /**
+     * Adiciona uma assinatura já calculada.
+     * @param signature Assinatura
+     * @return Identificador da entrada
+     */
+    int add_signature(const Signature& signature);
+
+    /**
+     * k vizinhos mais próximos de uma imagem.
+     * @param img Imagem de consulta (CV_8UC1 ou CV_8UC3 BGR)
+     * @param k Número de resultados
+     * @return Até k resultados em ordem crescente de distância (empate: menor id)
+     */
+    std::vector<Match> query(const cv::Mat& img, int k) const;
+
+    /**
+     * k vizinhos mais próximos de uma assinatura.
+     * @param signature Assinatura de consulta
+     * @param k Número de resultados
+     * @return Até k resultados em ordem crescente de distância (empate: menor id)
+     */
+    std::vector<Match> query(const Signature& signature, int k) const;
+
+    /**
+     * @return Número de imagens no índice
+     */
+    size_t size() const;
+
+    /**
+     * Remove todas as entradas.
+     */
+    void clear();
+
+    /**
+     * Grava o índice em arquivo binário.
+     * @param path Caminho do arquivo
+     * @return true se gravado, false em caso de erro
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Carrega um índice gravado por save (substitui o conteúdo atual).
+     * @param path Caminho do arquivo
+     * @return true se carregado, false em caso de erro (índice inalterado)
+     */
+    bool load(const std::string& path);
+
+    private:
+    // Assinaturas em sequência: a entrada i ocupa [i * BINS, (i + 1) * BINS)
+    std::vector<uint16_t> signatures_;
+};
+
+#endif // HISTOGRAM_INDEX_HPP
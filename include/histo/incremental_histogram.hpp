@@ -0,0 +1,116 @@
+#ifndef INCREMENTAL_HISTOGRAM_HPP
+#define INCREMENTAL_HISTOGRAM_HPP
+
+#include <opencv2/opencv.hpp>
+#include "histo/histogram.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Classe IncrementalHistogram
+ * ---------------------------
+ * Histograma mantido em sincronia com uma imagem que muda por regiões
+ * (sobreposições, atualização de blocos): as regiões alteradas têm o
+ * conteúdo antigo subtraído e o novo somado, com custo proporcional à área
+ * alterada em vez do tamanho da imagem.
+ *
+ * Funcionalidades:
+ * - Histograma inicial a partir da imagem completa (CV_8UC1 ou CV_8UC3)
+ * - Remoção/adição do conteúdo de retângulos sujos
+ * - Substituição direta de uma região (pixels antigos -> novos)
+ * - Contadores de 64 bits por canal (HistogramProcessor::HistogramCounts)
+ *
+ * Uso típico:
+ *   IncrementalHistogram hist{};
+ *   hist.reset(frame);
+ *   hist.remove_region(frame, dirty);   // antes de alterar a região
+ *   overlay.copyTo(frame(dirty));
+ *   hist.add_region(frame, dirty);      // depois de alterar a região
+ *   std::vector<int> gray = hist.histogram();
+ */
+class IncrementalHistogram
+{
+    public:
+        /**
+         * Construtor padrão (histograma vazio, sem canais).
+         */
+    IncrementalHistogram();
+
+    /**
+     * Destrutor.
+     */
+    ~IncrementalHistogram();
+
+    /**
+     * Recalcula o histograma a partir de uma imagem completa.
+     * @param img Imagem (CV_8UC1 ou CV_8UC3)
+     * @return true se a imagem for válida, false caso contrário
+     */
+    bool reset(const cv::Mat& img);
+
+    /**
+     * Soma o conteúdo de uma região ao histograma.
+     * @param img Imagem com o mesmo número de canais do histograma
+     * @param region Retângulo contido na imagem
+     * @return true se atualizado, false se a entrada for inválida
+     */
+    bool add_region(const cv::Mat& img, const cv::Rect& region);
+
+    /**
+     * Subtrai o conteúdo de uma região do histograma. Se a região contiver
+     * mais pixels de algum nível do que o histograma registra (conteúdo que
+     * nunca foi somado), nada é alterado.
+     * @param img Imagem com o mesmo número de canais do histograma
+     * @param region Retângulo contido na imagem
+     * @return true se atualizado, false se a entrada for inválida
+     */
+    bool remove_region(const cv::Mat& img, const cv::Rect& region);
+
+    /**
+     * Substitui o conteúdo de uma região: subtrai old_pixels e soma new_pixels.
+     * @param old_pixels Conteúdo anterior da região
+     * @param new_pixels Conteúdo novo (mesmo tamanho e tipo)
+     * @return true se atualizado, false se a entrada for inválida
+     */
+    bool replace_region(const cv::Mat& old_pixels, const cv::Mat& new_pixels);
+
+    /**
+     * Histograma de um canal, no formato de HistogramProcessor.
+     * @param channel Canal (0 em tons de cinza; 0=B, 1=G, 2=R em cores)
+     * @return Vetor com 256 elementos (vazio se o canal for inválido)
+     */
+    std::vector<int> histogram(int channel = 0) const;
+
+    /**
+     * Contadores de 64 bits de um canal (sem cópia).
+     * @param channel Canal (0 em tons de cinza; 0=B, 1=G, 2=R em cores)
+     * @return Contadores do canal
+     */
+    const HistogramProcessor::HistogramCounts& counts(int channel = 0) const;
+
+    /**
+     * @return Número de canais acompanhados (0 antes de reset)
+     */
+    int channels() const;
+
+    /**
+     * @return Número de pixels representados no histograma
+     */
+    uint64_t total() const;
+
+    private:
+        /**
+         * Conta os pixels de uma região em contadores locais (256 por canal).
+         */
+    bool count_region(const cv::Mat& img, const cv::Rect& region, std::vector<uint32_t>& local) const;
+
+    // Canais acompanhados (1 ou 3; 0 = vazio)
+    int channels_;
+    // Pixels representados
+    uint64_t total_;
+    // Contadores por canal
+    std::array<HistogramProcessor::HistogramCounts, 3> counts_;
+};
+
+#endif // INCREMENTAL_HISTOGRAM_HPP
@@ -0,0 +1,103 @@
+#ifndef INTEGRAL_HISTOGRAM_HPP
+#define INTEGRAL_HISTOGRAM_HPP
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Classe IntegralHistogram
+ * ------------------------
+ * Histograma integral de uma imagem em tons de cinza: para cada posição
+ * (x, y) guarda o histograma do retângulo [0, x) x [0, y). O histograma de
+ * qualquer retângulo sai de 4 leituras por bin, em O(bins), sem revisitar
+ * os pixels.
+ *
+ * Memória:
+ * - (rows + 1) * (cols + 1) * bins contadores de 32 bits
+ * - O número de bins (potência de 2 entre 1 e 256) controla o consumo:
+ *   o bin de um pixel é valor >> (8 - log2(bins))
+ * - estimate_memory informa o custo antes da construção
+ *
+ * Uso típico:
+ *   IntegralHistogram integral{};
+ *   if (IntegralHistogram::estimate_memory(gray.rows, gray.cols, 32) < limite)
+ *   {
+ *       integral.build(gray, 32);
+ *       std::vector<int> hist = integral.query(cv::Rect(10, 10, 64, 64));
+ *   }
+ */
+class IntegralHistogram
+{
+    public:
+        /**
+         * Construtor padrão (estrutura vazia).
+         */
+    IntegralHistogram();
+
+    /**
+     * Destrutor.
+     */
+    ~IntegralHistogram();
+
+    /**
+     * Memória necessária para o histograma integral, em bytes.
+     * @param rows Número de linhas da imagem
+     * @param cols Número de colunas da imagem
+     * @param bins Número de bins (potência de 2 entre 1 e 256)
+     * @return Bytes ocupados pela tabela (0 se os parâmetros forem inválidos)
+     */
+    static size_t estimate_memory(int rows, int cols, int bins);
+
+    /**
+     * Constrói o histograma integral em paralelo: somas prefixas por linha
+     * (linhas independentes) seguidas das somas acumuladas por coluna
+     * (faixas de colunas independentes).
+     * @param img Imagem em tons de cinza (CV_8UC1)
+     * @param bins Número de bins (potência de 2 entre 1 e 256; padrão: 256)
+     * @return true se construído, false se a entrada for inválida
+     */
+    bool build(const cv::Mat& img, int bins = 256);
+
+    /**
+     * Histograma de um retângulo em O(bins).
+     * @param region Retângulo contido na imagem
+     * @param histogram Saída: bins elementos (reaproveita a memória do vetor)
+     * @return true se a consulta for válida, false caso contrário
+     */
+    bool query(const cv::Rect& region, std::vector<int>& histogram) const;
+
+    /**
+     * Histograma de um retângulo em O(bins).
+     * @param region Retângulo contido na imagem
+     * @return Vetor com bins elementos (vazio se a consulta for inválida)
+     */
+    std::vector<int> query(const cv::Rect& region) const;
+
+    /**
+     * @return Número de bins (0 se vazio)
+     */
+    int bins() const;
+
+    /**
+     * @return true se o histograma integral ainda não foi construído
+     */
+    bool empty() const;
+
+    /**
+     * @return Memória ocupada pela tabela, em bytes
+     */
+    size_t memory_bytes() const;
+
+    private:
+    // Dimensões da imagem de origem
+    int rows_;
+    int cols_;
+    // Número de bins e deslocamento valor -> bin
+    int bins_;
+    int shift_;
+    // Tabela (rows + 1) x (cols + 1) x bins, linha a linha
+    std::vector<uint32_t> table_;
+};
+
+#endif // INTEGRAL_HISTOGRAM_HPP
@@ -0,0 +1,125 @@
+#ifndef POINT_LUT_HPP
+#define POINT_LUT_HPP
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <functional>
+
+/**
+ * Classe PointLut
+ * ---------------
+ * Tabela de consulta (lookup table) para operações pontuais de 8 bits,
+ * isto é, qualquer mapeamento uchar -> uchar que dependa apenas do valor
+ * do pixel (soma/multiplicação por escalar, inversão, limiarização, etc.).
+ *
+ * Funcionalidades:
+ * - Tabela única (aplicada a todos os canais) ou uma tabela por canal (B, G, R)
+ * - Composição: a.then(b) gera uma única tabela equivalente a aplicar a e depois b
+ * - Estado vazio (empty()) para operações inválidas, como divisão por zero:
+ *   propaga-se pela composição e faz apply falhar
+ * - Aplicação em uma passada sobre a imagem (vetorizada com AVX-512 VBMI)
+ *
+ * Uso típico:
+ *   ArithmeticOperations arith{};
+ *   ThresholdOperations thresh{};
+ *   PointLut chain = arith.add_scalar_lut(20)
+ *                        .then(arith.multiply_scalar_lut(1.3))
+ *                        .then(thresh.threshold_lut(128, ThresholdOperations::BINARY));
+ *   cv::Mat result = chain.apply(img);
+ */
+class PointLut
+{
+    public:
+        /**
+         * Tabela de 256 entradas indexada pelo valor do pixel.
+         */
+    typedef std::array<uchar, 256> Table;
+
+    /**
+     * Construtor padrão: tabela identidade (pixel -> pixel).
+     */
+    PointLut();
+
+    /**
+     * Constrói uma tabela única, aplicada igualmente a todos os canais.
+     * @param table Tabela de 256 entradas
+     */
+    explicit PointLut(const Table& table);
+
+    /**
+     * Constrói uma tabela por canal (ordem BGR do OpenCV).
+     * @param blue_table Tabela do canal azul
+     * @param green_table Tabela do canal verde
+     * @param red_table Tabela do canal vermelho
+     */
+    PointLut(const Table& blue_table, const Table& green_table, const Table& red_table);
+
+    /**
+     * Constrói uma tabela única avaliando uma função para os 256 valores.
+     * @param func Função uchar -> uchar
+     * @return Tabela com table[v] = func(v)
+     */
+    static PointLut from_function(const std::function<uchar(uchar)>& func);
+
+    /**
+     * Constrói uma tabela vazia, que representa uma operação inválida.
+     * @return Tabela com empty() == true
+     */
+    static PointLut invalid();
+
+    /**
+     * Indica se a tabela é vazia (operação inválida). Tabelas compostas com
+     * uma tabela vazia também são vazias e apply sobre elas falha.
+     * @return true se vazia, false caso contrário
+     */
+    bool empty() const;
+
+    /**
+     * Indica se a tabela possui entradas diferentes por canal.
+     * @return true se houver uma tabela por canal, false se for tabela única
+     */
+    bool is_per_channel() const;
+
+    /**
+     * Acessa a tabela de um canal.
+     * @param channel Índice do canal (0=B, 1=G, 2=R); ignorado em tabela única
+     * @return Tabela de 256 entradas
+     */
+    const Table& table(int channel = 0) const;
+
+    /**
+     * Compõe esta tabela com outra: o resultado equivale a aplicar esta
+     * tabela e, em seguida, next. Custo O(256) por canal.
+     * @param next Tabela aplicada depois desta
+     * @return Tabela composta (por canal se qualquer uma das duas for;
+     *         vazia se qualquer uma das duas for vazia)
+     */
+    PointLut then(const PointLut& next) const;
+
+    /**
+     * Aplica a tabela em uma imagem.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3; tabela por canal exige CV_8UC3)
+     * @return Imagem resultante (mesmo tipo e dimensões; vazia se a imagem ou a
+     *         tabela forem inválidas)
+     */
+    cv::Mat apply(const cv::Mat& img) const;
+
+    /**
+     * Aplica a tabela escrevendo em um buffer existente (realocado apenas se
+     * dimensões/tipo diferirem). Permite operação in-place (result == img).
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3; tabela por canal exige CV_8UC3)
+     * @param result Saída: imagem resultante
+     * @return true em caso de sucesso, false se a imagem ou a tabela forem inválidas
+     */
+    bool apply(const cv::Mat& img, cv::Mat& result) const;
+
+    private:
+        // Tabelas B, G, R (iguais entre si quando per_channel_ == false)
+    std::array<Table, 3> tables_;
+    // Indica se as tabelas diferem por canal
+    bool per_channel_;
+    // Indica tabela vazia (operação inválida)
+    bool empty_;
+};
+
+#endif // POINT_LUT_HPP
@@ -0,0 +1,81 @@
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Classe ConnectedComponents
+ * --------------------------
+ * Rotulação de componentes conexos em imagens binárias (ex.: saída de
+ * ThresholdOperations::binary_threshold), com estatísticas por componente
+ * (área, centróide e retângulo envolvente) calculadas na mesma passada.
+ *
+ * Algoritmo:
+ * - A imagem é dividida em faixas de linhas rotuladas em paralelo, cada uma
+ *   com union-find sobre um intervalo próprio de rótulos provisórios
+ * - As fronteiras entre faixas são unidas em seguida (O(largura) por fronteira)
+ * - Os rótulos são compactados para 1..N e as estatísticas provisórias
+ *   somadas ao rótulo final; a reescrita dos rótulos também é paralela
+ *
+ * Uso típico:
+ *   ConnectedComponents ccl{};
+ *   cv::Mat labels;
+ *   std::vector<ConnectedComponents::BlobStats> blobs;
+ *   int n = ccl.label_components(binary, labels, blobs);
+ */
+class ConnectedComponents
+{
+    public:
+        /**
+         * Vizinhança considerada para conectar pixels.
+         */
+    enum Connectivity
+    {
+        CONNECTIVITY_4 = 4,  // Vizinhos horizontais e verticais
+        CONNECTIVITY_8 = 8   // Inclui diagonais
+    };
+
+    /**
+     * Estatísticas de um componente conexo.
+     */
+    struct BlobStats
+    {
+        int label;              // Rótulo do componente (1..N)
+        int area;               // Número de pixels
+        double centroid_x;      // Coluna média
+        double centroid_y;      // Linha média
+        cv::Rect bounding_box;  // Retângulo envolvente
+    };
+
+    /**
+     * Construtor padrão.
+     */
+    ConnectedComponents();
+
+    /**
+     * Destrutor.
+     */
+    ~ConnectedComponents();
+
+    /**
+     * Rotula os componentes conexos de uma imagem binária.
+     * @param binary Imagem binária (CV_8UC1; pixels != 0 são primeiro plano)
+     * @param labels Saída: rótulos (CV_32SC1; 0 = fundo, 1..N = componentes)
+     * @param stats Saída: estatísticas; stats[i] descreve o rótulo i + 1
+     * @param connectivity Vizinhança (4 ou 8)
+     * @return Número de componentes N (-1 se a imagem for inválida)
+     */
+    int label_components(const cv::Mat& binary, cv::Mat& labels, std::vector<BlobStats>& stats,
+                         Connectivity connectivity = CONNECTIVITY_8);
+
+    /**
+     * Calcula apenas as estatísticas dos componentes (descarta os rótulos).
+     * @param binary Imagem binária (CV_8UC1; pixels != 0 são primeiro plano)
+     * @param connectivity Vizinhança (4 ou 8)
+     * @return Estatísticas por componente (vazio se não houver componentes)
+     */
+    std::vector<BlobStats> compute_blob_stats(const cv::Mat& binary, Connectivity connectivity = CONNECTIVITY_8);
+};
+
+#endif // CONNECTED_COMPONENTS_HPP
@@ -0,0 +1,170 @@
+#ifndef BINARY_IMAGE_HPP
+#define BINARY_IMAGE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Classe BinaryImage
+ * ------------------
+ * Imagem binária compactada em 1 bit por pixel (máscara), gerada diretamente
+ * pela limiarização (ThresholdOperations::binary_threshold_packed).
+ * Ocupa 1/8 da memória de uma máscara CV_8UC1 com valores 0/255.
+ *
+ * Layout:
+ * - Cada linha ocupa words_per_row() palavras de 64 bits
+ * - O pixel da coluna x fica no bit (x % 64) da palavra (x / 64)
+ * - Bits de preenchimento após a última coluna são sempre zero
+ *
+ * Funcionalidades:
+ * - Operações lógicas palavra a palavra (AND, OR, XOR, NOT)
+ * - Contagem de pixels ativos por popcount
+ * - Conversão de volta para cv::Mat (CV_8UC1)
+ *
+ * Uso típico:
+ *   ThresholdOperations thresh{};
+ *   BinaryImage mask_a = thresh.binary_threshold_packed(gray_a, 128);
+ *   BinaryImage mask_b = thresh.binary_threshold_packed(gray_b, 64);
+ *   size_t both = mask_a.logical_and(mask_b).count_nonzero();
+ *   cv::Mat visual = mask_a.to_mat();
+ */
+class BinaryImage
+{
+    public:
+        /**
+         * Construtor padrão (imagem vazia).
+         */
+    BinaryImage();
+
+    /**
+     * Cria uma imagem binária com todos os pixels desligados.
+     * Dimensões negativas são rejeitadas (imagem vazia).
+     * @param rows Número de linhas
+     * @param cols Número de colunas
+     */
+    BinaryImage(int rows, int cols);
+
+    /**
+     * Destrutor.
+     */
+    ~BinaryImage();
+
+    // ================ Acesso ================
+
+    /**
+     * @return Número de linhas
+     */
+    int rows() const;
+
+    /**
+     * @return Número de colunas
+     */
+    int cols() const;
+
+    /**
+     * @return true se a imagem não possui pixels
+     */
+    bool empty() const;
+
+    /**
+     * @return Número de palavras de 64 bits por linha (ceil(cols / 64))
+     */
+    int words_per_row() const;
+
+    /**
+     * Ponteiro para as palavras de uma linha.
+     * @param linha Índice da linha [0, rows)
+     * @return Primeira palavra da linha
+     */
+    uint64_t* row_ptr(int linha);
+
+    /**
+     * Ponteiro (somente leitura) para as palavras de uma linha.
+     * @param linha Índice da linha [0, rows)
+     * @return Primeira palavra da linha
+     */
+    const uint64_t* row_ptr(int linha) const;
+
+    /**
+     * Lê um pixel.
+     * @param linha Índice da linha
+     * @param coluna Índice da coluna
+     * @return true se o pixel estiver ligado
+     */
+    bool get(int linha, int coluna) const;
+
+    /**
+     * Escreve um pixel.
+     * @param linha Índice da linha
+     * @param coluna Índice da coluna
+     * @param value true para ligar o pixel, false para desligar
+     */
+    void set(int linha, int coluna, bool value);
+
+    // ================ Operações lógicas ================
+
+    /**
+     * Interseção pixel a pixel (mesmas dimensões).
+     * @param other Segunda máscara
+     * @return Máscara resultante (vazia se as dimensões diferirem)
+     */
+    BinaryImage logical_and(const BinaryImage& other) const;
+
+    /**
+     * União pixel a pixel (mesmas dimensões).
+     * @param other Segunda máscara
+     * @return Máscara resultante (vazia se as dimensões diferirem)
+     */
+    BinaryImage logical_or(const BinaryImage& other) const;
+
+    /**
+     * Diferença simétrica pixel a pixel (mesmas dimensões).
+     * @param other Segunda máscara
+     * @return Máscara resultante (vazia se as dimensões diferirem)
+     */
+    BinaryImage logical_xor(const BinaryImage& other) const;
+
+    /**
+     * Complemento (bits de preenchimento permanecem zero).
+     * @return Máscara invertida
+     */
+    BinaryImage logical_not() const;
+
+    // ================ Contagem e conversão ================
+
+    /**
+     * Conta os pixels ligados (popcount por palavra).
+     * @return Número de pixels ligados
+     */
+    size_t count_nonzero() const;
+
+    /**
+     * Expande para uma máscara de 8 bits.
+     * @param on_value Valor dos pixels ligados (desligados valem 0)
+     * @return Imagem CV_8UC1
+     */
+    cv::Mat to_mat(uchar on_value = 255) const;
+
+    private:
+        /**
+         * Aplica uma operação binária palavra a palavra.
+         */
+    template <typename Op>
+    BinaryImage combine(const BinaryImage& other, Op op) const;
+
+    /**
+     * Máscara dos bits válidos da última palavra de cada linha.
+     */
+    uint64_t tail_mask() const;
+
+    // Dimensões em pixels
+    int rows_;
+    int cols_;
+    // Palavras de 64 bits por linha
+    int words_per_row_;
+    // Palavras de todas as linhas, em sequência
+    std::vector<uint64_t> bits_;
+};
+
+#endif // BINARY_IMAGE_HPP
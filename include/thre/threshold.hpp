@@ -2,6 +2,9 @@
 #define THRESHOLD_HPP
 
 #include <opencv2/opencv.hpp>
+#include "lut/point_lut.hpp"
+#include "thre/binary_image.hpp"
+#include <vector>
 
 /**
  * Classe ThresholdOperations
@@ -16,6 +19,11 @@
  * - Limiarização para zero
  * - Limiarização para zero invertida
  * - Suporte para imagens coloridas (aplica em todos os canais)
+ * - Limiarização automática (Otsu e triângulo) a partir do histograma
+ * - Saída binária compactada em 1 bit por pixel (BinaryImage)
+ * - Limiarização adaptativa local (média e Sauvola) com imagens integrais
+ * - Kernels especializados por tipo (template), vetorizados sem desvios
+ *   (comparação + and/andnot/min em SSE2/AVX2/AVX-512)
  *
  * Uso típico:
  *   ThresholdOperations thresh{};
@@ -37,6 +45,12 @@ class ThresholdOperations
         TO_ZERO_INV      // pixel > thresh ? 0 : pixel
     };
 
+    /**
+     * Lado máximo da janela adaptativa (somas de 32 bits exatas:
+     * 255 * bloco^2 < 2^32).
+     */
+    static constexpr int MAX_ADAPTIVE_BLOCK = 4103;
+
     /**
      * Construtor padrão.
      */
@@ -67,6 +81,18 @@ class ThresholdOperations
      */
     cv::Mat binary_threshold_inv(const cv::Mat& img, uchar threshold_value, uchar max_value = 255);
 
+    /**
+     * Limiarização binária do cinza ponderado (BT.601) de uma imagem BGR, em
+     * uma única passada fundida (GrayScale::threshold_weighted): equivale a
+     * binary_threshold(get_gray_weighted(), ...) sem a imagem cinza
+     * intermediária.
+     * @param img Imagem de entrada (CV_8UC3 BGR)
+     * @param threshold_value Valor limiar [0, 255]
+     * @param max_value Valor máximo a ser atribuído [0, 255]
+     * @return Imagem binária (CV_8UC1; vazia se a imagem for inválida)
+     */
+    cv::Mat binary_threshold_luma(const cv::Mat& img, uchar threshold_value, uchar max_value = 255);
+
     /**
      * Aplica limiarização truncada em imagem em tons de cinza.
      * @param img Imagem de entrada (CV_8UC1)
@@ -91,6 +117,25 @@ class ThresholdOperations
      */
     cv::Mat to_zero_inv_threshold(const cv::Mat& img, uchar threshold_value);
 
+    /**
+     * Limiarização binária com saída compactada em 1 bit por pixel:
+     * bit ligado se pixel > threshold_value. As máscaras de comparação
+     * vetoriais viram bits diretamente (movemask / máscara AVX-512).
+     * @param img Imagem de entrada (CV_8UC1)
+     * @param threshold_value Valor limiar [0, 255]
+     * @return Máscara compactada (vazia se a imagem for inválida)
+     */
+    BinaryImage binary_threshold_packed(const cv::Mat& img, uchar threshold_value);
+
+    /**
+     * Limiarização binária invertida com saída compactada:
+     * bit ligado se pixel <= threshold_value.
+     * @param img Imagem de entrada (CV_8UC1)
+     * @param threshold_value Valor limiar [0, 255]
+     * @return Máscara compactada (vazia se a imagem for inválida)
+     */
+    BinaryImage binary_threshold_inv_packed(const cv::Mat& img, uchar threshold_value);
+
     // ================ Limiarização para imagens coloridas ================
 
     /**
@@ -124,15 +169,119 @@ class ThresholdOperations
      */
     cv::Mat apply_threshold(const cv::Mat& img, uchar threshold_value, ThresholdType type, uchar max_value = 255);
 
+    /**
+     * Constrói a tabela de consulta equivalente a apply_threshold, para
+     * composição com outras operações pontuais (ver PointLut::then).
+     * @param threshold_value Valor limiar [0, 255]
+     * @param type Tipo de limiarização
+     * @param max_value Valor máximo (usado apenas em tipos BINARY)
+     * @return Tabela com table[v] = limiarização de v
+     */
+    PointLut threshold_lut(uchar threshold_value, ThresholdType type, uchar max_value = 255);
+
+    // ================ Limiarização automática ================
+
+    /**
+     * Limiarização binária com limiar escolhido pelo método de Otsu
+     * (maximiza a variância entre classes).
+     * Imagem cinza: uma passada para o histograma e outra para limiarizar.
+     * Imagem BGR: o histograma é acumulado durante a conversão ponderada para
+     * cinza (GrayScale::get_gray_weighted_histogram), também em duas passadas.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3 BGR)
+     * @param max_value Valor atribuído aos pixels acima do limiar [0, 255]
+     * @return Imagem binária (CV_8UC1)
+     */
+    cv::Mat otsu_threshold(const cv::Mat& img, uchar max_value = 255);
+
+    /**
+     * Limiarização binária com limiar escolhido pelo método do triângulo
+     * (adequado a histogramas unimodais com um pico dominante).
+     * Mesmas regras de entrada e número de passadas de otsu_threshold.
+     * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3 BGR)
+     * @param max_value Valor atribuído aos pixels acima do limiar [0, 255]
+     * @return Imagem binária (CV_8UC1)
+     */
+    cv::Mat triangle_threshold(const cv::Mat& img, uchar max_value = 255);
+
+    /**
+     * Calcula o limiar de Otsu a partir de um histograma, em O(256).
+     * Pixels com valor <= limiar formam uma classe e > limiar a outra.
+     * @param histogram Histograma com 256 elementos (ex.: HistogramProcessor::compute_histogram_gray)
+     * @return Limiar ótimo [0, 255] (0 se o histograma for inválido ou vazio)
+     */
+    uchar compute_otsu_threshold(const std::vector<int>& histogram);
+
+    /**
+     * Calcula o limiar pelo método do triângulo a partir de um histograma, em O(256).
+     * @param histogram Histograma com 256 elementos
+     * @return Limiar [0, 255] (0 se o histograma for inválido ou vazio)
+     */
+    uchar compute_triangle_threshold(const std::vector<int>& histogram);
+
+    // ================ Limiarização adaptativa (local) ================
+
+    /**
+     * Limiarização adaptativa pela média local: pixel > média(janela) - c ? max_value : 0.
+     * A média de cada janela vem de uma tabela de somas acumuladas (imagem
+     * integral), com custo O(1) por pixel independente do tamanho da janela.
+     * Janelas são recortadas nas bordas da imagem.
+     * @param img Imagem de entrada (CV_8UC1)
+     * @param block_size Lado da janela (ímpar, 3 a MAX_ADAPTIVE_BLOCK)
+     * @param c Constante subtraída da média
+     * @param max_value Valor atribuído aos pixels acima do limiar [0, 255]
+     * @param low_memory Se true, mantém apenas uma faixa deslizante de somas
+     *                   por coluna (memória O(largura) por thread) em vez da
+     *                   imagem integral completa; indicado para imagens muito altas
+     * @return Imagem binária (CV_8UC1)
+     */
+    cv::Mat adaptive_mean_threshold(const cv::Mat& img, int block_size, double c, uchar max_value = 255, bool low_memory = false);
+
+    /**
+     * Limiarização adaptativa de Sauvola: T = m * (1 + k * (s / r - 1)), onde m e s
+     * são a média e o desvio padrão da janela (somas e somas dos quadrados
+     * acumuladas, custo O(1) por pixel).
+     * @param img Imagem de entrada (CV_8UC1)
+     * @param block_size Lado da janela (ímpar, 3 a MAX_ADAPTIVE_BLOCK)
+     * @param k Sensibilidade ao contraste local (típico: 0.2 a 0.5)
+     * @param r Faixa dinâmica do desvio padrão (> 0; típico: 128)
+     * @param max_value Valor atribuído aos pixels acima do limiar [0, 255]
+     * @param low_memory Mesmo significado de adaptive_mean_threshold
+     * @return Imagem binária (CV_8UC1)
+     */
+    cv::Mat sauvola_threshold(const cv::Mat& img, int block_size, double k = 0.34, double r = 128.0, uchar max_value = 255, bool low_memory = false);
+
     private:
         /**
-         * Aplica limiarização em um único pixel.
-         * @param pixel_value Valor do pixel [0, 255]
-         * @param threshold_value Valor limiar [0, 255]
-         * @param type Tipo de limiarização
-         * @param max_value Valor máximo (usado apenas em tipos BINARY)
-         * @return Valor do pixel após limiarização
+         * Obtém imagem cinza e histograma para a limiarização automática.
+         * @param img Imagem de entrada (CV_8UC1 ou CV_8UC3 BGR)
+         * @param gray Saída: imagem em tons de cinza
+         * @param histogram Saída: histograma de 256 níveis de gray
+         * @return true em caso de sucesso, false se a imagem for inválida
          */
+    bool gray_and_histogram(const cv::Mat& img, cv::Mat& gray, std::vector<int>& histogram);
+
+    /**
+     * Implementação comum das limiarizações adaptativas (validação e despacho
+     * entre imagem integral completa e faixa deslizante).
+     * @param img Imagem de entrada (CV_8UC1)
+     * @param block_size Lado da janela (ímpar, 3 a MAX_ADAPTIVE_BLOCK)
+     * @param sauvola true para Sauvola, false para média local
+     * @param param c (média) ou k (Sauvola)
+     * @param range r (Sauvola; deve ser positivo)
+     * @param max_value Valor atribuído aos pixels acima do limiar
+     * @param low_memory Usa faixa deslizante em vez da integral completa
+     * @return Imagem binária (CV_8UC1)
+     */
+    cv::Mat adaptive_threshold(const cv::Mat& img, int block_size, bool sauvola, double param, double range, uchar max_value, bool low_memory);
+
+    /**
+     * Aplica limiarização em um único pixel.
+     * @param pixel_value Valor do pixel [0, 255]
+     * @param threshold_value Valor limiar [0, 255]
+     * @param type Tipo de limiarização
+     * @param max_value Valor máximo (usado apenas em tipos BINARY)
+     * @return Valor do pixel após limiarização
+     */
     uchar apply_threshold_pixel(uchar pixel_value, uchar threshold_value, ThresholdType type, uchar max_value);
 };
 
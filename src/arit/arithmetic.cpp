@@ -1,7 +1,238 @@
 #include "arit/arithmetic.hpp"
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Soma saturada byte a byte: out[i] = min(a[i] + b[i], 255).
+     * Usa o maior vetor disponível em tempo de compilação (AVX-512BW: 64 bytes,
+     * AVX2: 32 bytes, SSE2: 16 bytes) e finaliza a cauda com código escalar.
+     * O resultado é idêntico bit a bit ao caminho escalar.
+     */
+    void add_saturate_u8(const uchar* a, const uchar* b, uchar* out, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX512BW__)
+        for (; i + 64 <= n; i += 64)
+        {
+            __m512i va = _mm512_loadu_si512(reinterpret_cast<const void*>(a + i));
+            __m512i vb = _mm512_loadu_si512(reinterpret_cast<const void*>(b + i));
+            _mm512_storeu_si512(reinterpret_cast<void*>(out + i), _mm512_adds_epu8(va, vb));
+        }
+#endif
+#if defined(__AVX2__)
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_adds_epu8(va, vb));
+        }
+#endif
+#if defined(__SSE2__)
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_adds_epu8(va, vb));
+        }
+#endif
+        for (; i < n; i++)
+        {
+            int sum = static_cast<int>(a[i]) + static_cast<int>(b[i]);
+            out[i] = static_cast<uchar>(sum > 255 ? 255 : sum);
+        }
+    }
+
+    /**
+     * Subtração saturada byte a byte: out[i] = max(a[i] - b[i], 0).
+     * Mesma estratégia de vetorização de add_saturate_u8.
+     */
+    void subtract_saturate_u8(const uchar* a, const uchar* b, uchar* out, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX512BW__)
+        for (; i + 64 <= n; i += 64)
+        {
+            __m512i va = _mm512_loadu_si512(reinterpret_cast<const void*>(a + i));
+            __m512i vb = _mm512_loadu_si512(reinterpret_cast<const void*>(b + i));
+            _mm512_storeu_si512(reinterpret_cast<void*>(out + i), _mm512_subs_epu8(va, vb));
+        }
+#endif
+#if defined(__AVX2__)
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_subs_epu8(va, vb));
+        }
+#endif
+#if defined(__SSE2__)
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_subs_epu8(va, vb));
+        }
+#endif
+        for (; i < n; i++)
+        {
+            int diff = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+            out[i] = static_cast<uchar>(diff < 0 ? 0 : diff);
+        }
+    }
+
+    /**
+     * Multiplicação normalizada byte a byte: out[i] = floor(a[i] * b[i] / 255).
+     * O produto de 16 bits é dividido por 255 sem divisão, pela identidade
+     * exata floor(p / 255) = (p + 1 + (p >> 8)) >> 8, válida para p <= 65025.
+     */
+    void multiply_normalized_u8(const uchar* a, const uchar* b, uchar* out, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX512BW__)
+        const __m512i zero512 = _mm512_setzero_si512();
+        const __m512i one512 = _mm512_set1_epi16(1);
+        for (; i + 64 <= n; i += 64)
+        {
+            __m512i va = _mm512_loadu_si512(reinterpret_cast<const void*>(a + i));
+            __m512i vb = _mm512_loadu_si512(reinterpret_cast<const void*>(b + i));
+            __m512i plo = _mm512_mullo_epi16(_mm512_unpacklo_epi8(va, zero512), _mm512_unpacklo_epi8(vb, zero512));
+            __m512i phi = _mm512_mullo_epi16(_mm512_unpackhi_epi8(va, zero512), _mm512_unpackhi_epi8(vb, zero512));
+            plo = _mm512_srli_epi16(_mm512_add_epi16(_mm512_add_epi16(plo, one512), _mm512_srli_epi16(plo, 8)), 8);
+            phi = _mm512_srli_epi16(_mm512_add_epi16(_mm512_add_epi16(phi, one512), _mm512_srli_epi16(phi, 8)), 8);
+            _mm512_storeu_si512(reinterpret_cast<void*>(out + i), _mm512_packus_epi16(plo, phi));
+        }
+#endif
+#if defined(__AVX2__)
+        const __m256i zero256 = _mm256_setzero_si256();
+        const __m256i one256 = _mm256_set1_epi16(1);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i plo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(va, zero256), _mm256_unpacklo_epi8(vb, zero256));
+            __m256i phi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(va, zero256), _mm256_unpackhi_epi8(vb, zero256));
+            plo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(plo, one256), _mm256_srli_epi16(plo, 8)), 8);
+            phi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(phi, one256), _mm256_srli_epi16(phi, 8)), 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(plo, phi));
+        }
+#endif
+#if defined(__SSE2__)
+        const __m128i zero128 = _mm_setzero_si128();
+        const __m128i one128 = _mm_set1_epi16(1);
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i plo = _mm_mullo_epi16(_mm_unpacklo_epi8(va, zero128), _mm_unpacklo_epi8(vb, zero128));
+            __m128i phi = _mm_mullo_epi16(_mm_unpackhi_epi8(va, zero128), _mm_unpackhi_epi8(vb, zero128));
+            plo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(plo, one128), _mm_srli_epi16(plo, 8)), 8);
+            phi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(phi, one128), _mm_srli_epi16(phi, 8)), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(plo, phi));
+        }
+#endif
+        for (; i < n; i++)
+        {
+            unsigned int prod = static_cast<unsigned int>(a[i]) * static_cast<unsigned int>(b[i]);
+            out[i] = static_cast<uchar>((prod + 1 + (prod >> 8)) >> 8);
+        }
+    }
+
+    /**
+     * Tabela de recíprocos em ponto fixo Q24: recip[b] = ceil(255 * 2^24 / b).
+     * Para a < b, (a * recip[b]) >> 24 == floor(a * 255 / b) para todo par de
+     * bytes, e o produto cabe em 32 bits. Se a >= b (incluindo b == 0) o
+     * resultado satura em 255, o que coincide com a proteção contra divisão
+     * por zero.
+     */
+    const uint32_t* reciprocal_table()
+    {
+        static const std::array<uint32_t, 256> table = []()
+        {
+            std::array<uint32_t, 256> t{};
+            t[0] = 0; // Nunca usado: b == 0 implica a >= b
+            for (uint32_t b = 1; b < 256; b++)
+            {
+                t[b] = static_cast<uint32_t>(((255ULL << 24) + b - 1) / b);
+            }
+            return t;
+        }();
+        return table.data();
+    }
+
+    /**
+     * Divisão normalizada byte a byte: out[i] = min(255, floor(a[i] * 255 / b[i])),
+     * com out[i] = 255 quando b[i] == 0. Usa a tabela de recíprocos; com AVX2 os
+     * recíprocos são lidos por gather e multiplicados em 32 bits.
+     */
+    void divide_normalized_u8(const uchar* a, const uchar* b, uchar* out, size_t n)
+    {
+        const uint32_t* recip = reciprocal_table();
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i sat256 = _mm256_set1_epi32(255);
+        for (; i + 16 <= n; i += 16)
+        {
+            __m256i q[2];
+            for (int metade = 0; metade < 2; metade++)
+            {
+                __m256i va = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i + 8 * metade)));
+                __m256i vb = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i + 8 * metade)));
+                __m256i r = _mm256_i32gather_epi32(reinterpret_cast<const int*>(recip), vb, 4);
+                __m256i quot = _mm256_srli_epi32(_mm256_mullo_epi32(va, r), 24);
+                // Valores < 256, portanto a comparação com sinal é segura
+                __m256i below = _mm256_cmpgt_epi32(vb, va);
+                q[metade] = _mm256_blendv_epi8(sat256, quot, below);
+            }
+            // packus intercala as metades de 128 bits; permute restaura a ordem
+            __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(q[0], q[1]), 0xD8);
+            __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+        }
+#endif
+        for (; i < n; i++)
+        {
+            if (a[i] >= b[i])
+            {
+                out[i] = 255; // Inclui a proteção contra divisão por zero
+            }
+            else
+            {
+                out[i] = static_cast<uchar>((static_cast<uint32_t>(a[i]) * recip[b[i]]) >> 24);
+            }
+        }
+    }
+
+    /**
+     * Aplica um kernel binário sobre as três imagens como sequência de bytes.
+     * Se todas forem contínuas, o kernel é chamado uma única vez sobre a
+     * imagem inteira; caso contrário (ROIs), é chamado linha a linha.
+     */
+    template <typename Kernel>
+    void for_each_byte_span(const cv::Mat& img1, const cv::Mat& img2, cv::Mat& result, Kernel kernel)
+    {
+        const size_t row_bytes = static_cast<size_t>(img1.cols) * img1.elemSize();
+
+        if (img1.isContinuous() && img2.isContinuous() && result.isContinuous())
+        {
+            kernel(img1.ptr<uchar>(0), img2.ptr<uchar>(0), result.ptr<uchar>(0), row_bytes * img1.rows);
+            return;
+        }
+
+        for (int linha = 0; linha < img1.rows; linha++)
+        {
+            kernel(img1.ptr<uchar>(linha), img2.ptr<uchar>(linha), result.ptr<uchar>(linha), row_bytes);
+        }
+    }
+}
+
 ArithmeticOperations::ArithmeticOperations()
 {
 }
@@ -24,6 +255,11 @@ bool ArithmeticOperations::are_images_compatible(const cv::Mat& img1, const cv::
         !img2.empty());
 }
 
+bool ArithmeticOperations::is_supported_type(const cv::Mat& img)
+{
+    return (img.type() == CV_8UC1 || img.type() == CV_8UC3);
+}
+
 // ================ Operações Imagem + Imagem ================
 
 cv::Mat ArithmeticOperations::add_images(const cv::Mat& img1, const cv::Mat& img2)
@@ -34,42 +270,17 @@ cv::Mat ArithmeticOperations::add_images(const cv::Mat& img1, const cv::Mat& img
         return cv::Mat();
     }
 
-    cv::Mat result(img1.rows, img1.cols, img1.type());
-
-    if (img1.channels() == 1) // Imagem em tons de cinza
+    if (!is_supported_type(img1))
     {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const uchar* pixel1 = img1.ptr<uchar>(linha);
-            const uchar* pixel2 = img2.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                double sum = static_cast<double>(pixel1[coluna]) + static_cast<double>(pixel2[coluna]);
-                pixel_out[coluna] = clamp_to_uchar(sum);
-            }
-        }
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+        return cv::Mat();
     }
-    else if (img1.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const cv::Vec3b* pixel1 = img1.ptr<cv::Vec3b>(linha);
-            const cv::Vec3b* pixel2 = img2.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
 
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    double sum = static_cast<double>(pixel1[coluna][canal]) +
-                        static_cast<double>(pixel2[coluna][canal]);
-                    pixel_out[coluna][canal] = clamp_to_uchar(sum);
-                }
-            }
-        }
-    }
+    cv::Mat result(img1.rows, img1.cols, img1.type());
+
+    // 8UC1 e 8UC3 são tratadas como um fluxo contínuo de bytes: a soma
+    // saturada não depende do canal, apenas da posição do byte.
+    for_each_byte_span(img1, img2, result, add_saturate_u8);
 
     return result;
 }
@@ -82,42 +293,15 @@ cv::Mat ArithmeticOperations::subtract_images(const cv::Mat& img1, const cv::Mat
         return cv::Mat();
     }
 
-    cv::Mat result(img1.rows, img1.cols, img1.type());
-
-    if (img1.channels() == 1) // Imagem em tons de cinza
+    if (!is_supported_type(img1))
     {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const uchar* pixel1 = img1.ptr<uchar>(linha);
-            const uchar* pixel2 = img2.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                double diff = static_cast<double>(pixel1[coluna]) - static_cast<double>(pixel2[coluna]);
-                pixel_out[coluna] = clamp_to_uchar(diff);
-            }
-        }
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+        return cv::Mat();
     }
-    else if (img1.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const cv::Vec3b* pixel1 = img1.ptr<cv::Vec3b>(linha);
-            const cv::Vec3b* pixel2 = img2.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
 
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    double diff = static_cast<double>(pixel1[coluna][canal]) -
-                        static_cast<double>(pixel2[coluna][canal]);
-                    pixel_out[coluna][canal] = clamp_to_uchar(diff);
-                }
-            }
-        }
-    }
+    cv::Mat result(img1.rows, img1.cols, img1.type());
+
+    for_each_byte_span(img1, img2, result, subtract_saturate_u8);
 
     return result;
 }
@@ -130,45 +314,17 @@ cv::Mat ArithmeticOperations::multiply_images(const cv::Mat& img1, const cv::Mat
         return cv::Mat();
     }
 
-    cv::Mat result(img1.rows, img1.cols, img1.type());
-
-    if (img1.channels() == 1) // Imagem em tons de cinza
+    if (!is_supported_type(img1))
     {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const uchar* pixel1 = img1.ptr<uchar>(linha);
-            const uchar* pixel2 = img2.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                // Normaliza para [0,1], multiplica e desnormaliza
-                double mult = (static_cast<double>(pixel1[coluna]) / 255.0) *
-                    (static_cast<double>(pixel2[coluna]) / 255.0) * 255.0;
-                pixel_out[coluna] = clamp_to_uchar(mult);
-            }
-        }
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+        return cv::Mat();
     }
-    else if (img1.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const cv::Vec3b* pixel1 = img1.ptr<cv::Vec3b>(linha);
-            const cv::Vec3b* pixel2 = img2.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
 
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    // Normaliza para [0,1], multiplica e desnormaliza
-                    double mult = (static_cast<double>(pixel1[coluna][canal]) / 255.0) *
-                        (static_cast<double>(pixel2[coluna][canal]) / 255.0) * 255.0;
-                    pixel_out[coluna][canal] = clamp_to_uchar(mult);
-                }
-            }
-        }
-    }
+    cv::Mat result(img1.rows, img1.cols, img1.type());
+
+    // Normaliza para [0,1], multiplica e desnormaliza: (a/255)*(b/255)*255 = a*b/255,
+    // calculado em ponto fixo de 16 bits.
+    for_each_byte_span(img1, img2, result, multiply_normalized_u8);
 
     return result;
 }
@@ -181,57 +337,16 @@ cv::Mat ArithmeticOperations::divide_images(const cv::Mat& img1, const cv::Mat&
         return cv::Mat();
     }
 
-    cv::Mat result(img1.rows, img1.cols, img1.type());
-
-    if (img1.channels() == 1) // Imagem em tons de cinza
+    if (!is_supported_type(img1))
     {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const uchar* pixel1 = img1.ptr<uchar>(linha);
-            const uchar* pixel2 = img2.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                if (pixel2[coluna] == 0)
-                {
-                    pixel_out[coluna] = 255; // Proteção contra divisão por zero
-                }
-                else
-                {
-                    double div = (static_cast<double>(pixel1[coluna]) /
-                        static_cast<double>(pixel2[coluna])) * 255.0;
-                    pixel_out[coluna] = clamp_to_uchar(div);
-                }
-            }
-        }
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+        return cv::Mat();
     }
-    else if (img1.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img1.rows; linha++)
-        {
-            const cv::Vec3b* pixel1 = img1.ptr<cv::Vec3b>(linha);
-            const cv::Vec3b* pixel2 = img2.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
 
-            for (int coluna = 0; coluna < img1.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    if (pixel2[coluna][canal] == 0)
-                    {
-                        pixel_out[coluna][canal] = 255; // Proteção contra divisão por zero
-                    }
-                    else
-                    {
-                        double div = (static_cast<double>(pixel1[coluna][canal]) /
-                            static_cast<double>(pixel2[coluna][canal])) * 255.0;
-                        pixel_out[coluna][canal] = clamp_to_uchar(div);
-                    }
-                }
-            }
-        }
-    }
+    cv::Mat result(img1.rows, img1.cols, img1.type());
+
+    // (a / b) * 255 com saturação; divisor zero resulta em 255.
+    for_each_byte_span(img1, img2, result, divide_normalized_u8);
 
     return result;
 }
@@ -246,41 +361,7 @@ cv::Mat ArithmeticOperations::add_scalar(const cv::Mat& img, double scalar)
         return cv::Mat();
     }
 
-    cv::Mat result(img.rows, img.cols, img.type());
-
-    if (img.channels() == 1) // Imagem em tons de cinza
-    {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const uchar* pixel_in = img.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                double sum = static_cast<double>(pixel_in[coluna]) + scalar;
-                pixel_out[coluna] = clamp_to_uchar(sum);
-            }
-        }
-    }
-    else if (img.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const cv::Vec3b* pixel_in = img.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
-
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    double sum = static_cast<double>(pixel_in[coluna][canal]) + scalar;
-                    pixel_out[coluna][canal] = clamp_to_uchar(sum);
-                }
-            }
-        }
-    }
-
-    return result;
+    return add_scalar_lut(scalar).apply(img);
 }
 
 cv::Mat ArithmeticOperations::subtract_scalar(const cv::Mat& img, double scalar)
@@ -296,50 +377,54 @@ cv::Mat ArithmeticOperations::multiply_scalar(const cv::Mat& img, double scalar)
         return cv::Mat();
     }
 
-    cv::Mat result(img.rows, img.cols, img.type());
+    return multiply_scalar_lut(scalar).apply(img);
+}
 
-    if (img.channels() == 1) // Imagem em tons de cinza
+cv::Mat ArithmeticOperations::divide_scalar(const cv::Mat& img, double scalar)
+{
+    if (scalar == 0.0)
     {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const uchar* pixel_in = img.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                double mult = static_cast<double>(pixel_in[coluna]) * scalar;
-                pixel_out[coluna] = clamp_to_uchar(mult);
-            }
-        }
+        std::cerr << "Erro: Divisão por zero!" << std::endl;
+        return cv::Mat();
     }
-    else if (img.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const cv::Vec3b* pixel_in = img.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
 
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    double mult = static_cast<double>(pixel_in[coluna][canal]) * scalar;
-                    pixel_out[coluna][canal] = clamp_to_uchar(mult);
-                }
-            }
-        }
+    return multiply_scalar(img, 1.0 / scalar);
+}
+
+// ================ Tabelas de consulta (operações pontuais) ================
+
+PointLut ArithmeticOperations::add_scalar_lut(double scalar)
+{
+    PointLut::Table table;
+    for (int v = 0; v < 256; v++)
+    {
+        table[v] = clamp_to_uchar(static_cast<double>(v) + scalar);
     }
+    return PointLut(table);
+}
 
-    return result;
+PointLut ArithmeticOperations::subtract_scalar_lut(double scalar)
+{
+    return add_scalar_lut(-scalar);
 }
 
-cv::Mat ArithmeticOperations::divide_scalar(const cv::Mat& img, double scalar)
+PointLut ArithmeticOperations::multiply_scalar_lut(double scalar)
+{
+    PointLut::Table table;
+    for (int v = 0; v < 256; v++)
+    {
+        table[v] = clamp_to_uchar(static_cast<double>(v) * scalar);
+    }
+    return PointLut(table);
+}
+
+PointLut ArithmeticOperations::divide_scalar_lut(double scalar)
 {
     if (scalar == 0.0)
     {
         std::cerr << "Erro: Divisão por zero!" << std::endl;
-        return cv::Mat();
+        return PointLut::invalid();
     }
 
-    return multiply_scalar(img, 1.0 / scalar);
+    return multiply_scalar_lut(1.0 / scalar);
 }
@@ -0,0 +1,38 @@
+#include "conv/buffer_pool.hpp"
+
+BufferPool::BufferPool()
+{
+}
+
+BufferPool::~BufferPool()
+{
+}
+
+cv::Mat BufferPool::acquire(cv::Size size)
+{
+    for (size_t i = 0; i < buffers_.size(); i++)
+    {
+        if (buffers_[i].cols == size.width && buffers_[i].rows == size.height)
+        {
+            cv::Mat buffer = buffers_[i];
+            buffers_[i] = buffers_.back();
+            buffers_.pop_back();
+            return buffer;
+        }
+    }
+    return cv::Mat(size.height, size.width, CV_8UC1);
+}
+
+void BufferPool::recycle(cv::Mat& buffer)
+{
+    if (!buffer.empty() && buffer.type() == CV_8UC1)
+    {
+        buffers_.push_back(buffer);
+    }
+    buffer = cv::Mat();
+}
+
+void BufferPool::clear()
+{
+    buffers_.clear();
+}
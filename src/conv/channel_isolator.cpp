@@ -1,6 +1,44 @@
 #include "conv/channel_isolator.hpp"
+#include "conv/bgr_simd.hpp"
 #include <iostream>
 
+namespace
+{
+    /**
+     * Separa `count` pixels BGR consecutivos em três planos.
+     */
+    void split_span(const uchar* in, uchar* blue, uchar* green, uchar* red, size_t count)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 32 <= count; i += 32)
+        {
+            __m256i b, g, r;
+            bgr_simd::deinterleave_bgr_256(in + 3 * i, b, g, r);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(blue + i), b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(green + i), g);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(red + i), r);
+        }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i b, g, r;
+            bgr_simd::deinterleave_bgr_128(in + 3 * i, b, g, r);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(blue + i), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(green + i), g);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(red + i), r);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            blue[i] = in[3 * i];
+            green[i] = in[3 * i + 1];
+            red[i] = in[3 * i + 2];
+        }
+    }
+}
+
 ChannelIsolator::ChannelIsolator()
 {
 }
@@ -63,6 +101,56 @@ cv::Mat ChannelIsolator::extract_channel(const cv::Mat& img, Channel channel)
     return result;
 }
 
+bool ChannelIsolator::split_channels(const cv::Mat& img, cv::Mat& blue, cv::Mat& green, cv::Mat& red)
+{
+    if (!is_valid_color_image(img))
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (3 canais BGR)!" << std::endl;
+        return false;
+    }
+
+    blue.create(img.rows, img.cols, CV_8UC1);
+    green.create(img.rows, img.cols, CV_8UC1);
+    red.create(img.rows, img.cols, CV_8UC1);
+
+    // Tudo contínuo: uma única sequência de pixels
+    const bool flat = img.isContinuous() && blue.isContinuous() && green.isContinuous() && red.isContinuous();
+    const int span_rows = flat ? 1 : img.rows;
+    const size_t span_pixels = flat ? img.total() : static_cast<size_t>(img.cols);
+
+    for (int linha = 0; linha < span_rows; linha++)
+    {
+        split_span(img.ptr<uchar>(linha), blue.ptr<uchar>(linha), green.ptr<uchar>(linha),
+                   red.ptr<uchar>(linha), span_pixels);
+    }
+    return true;
+}
+
+bool ChannelIsolator::split_channels_pooled(const cv::Mat& img, cv::Mat& blue, cv::Mat& green, cv::Mat& red)
+{
+    if (!is_valid_color_image(img))
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (3 canais BGR)!" << std::endl;
+        return false;
+    }
+
+    const cv::Size size(img.cols, img.rows);
+    blue = pool_.acquire(size);
+    green = pool_.acquire(size);
+    red = pool_.acquire(size);
+    return split_channels(img, blue, green, red);
+}
+
+void ChannelIsolator::recycle_buffer(cv::Mat& buffer)
+{
+    pool_.recycle(buffer);
+}
+
+void ChannelIsolator::release_buffers()
+{
+    pool_.clear();
+}
+
 // ================ Isolamento de canais (mantém imagem colorida) ================
 
 cv::Mat ChannelIsolator::isolate_blue_channel(const cv::Mat& img)
@@ -148,42 +236,21 @@ cv::Mat ChannelIsolator::invert_image(const cv::Mat& img)
         return cv::Mat();
     }
 
-    cv::Mat result(img.rows, img.cols, img.type());
-
-    if (img.channels() == 1) // Imagem em tons de cinza
-    {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const uchar* pixel_in = img.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
-
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                pixel_out[coluna] = 255 - pixel_in[coluna];
-            }
-        }
-    }
-    else if (img.channels() == 3) // Imagem colorida
-    {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const cv::Vec3b* pixel_in = img.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
-
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    pixel_out[coluna][canal] = 255 - pixel_in[coluna][canal];
-                }
-            }
-        }
-    }
-    else
+    if (img.channels() != 1 && img.channels() != 3)
     {
         std::cerr << "Erro: Tipo de imagem não suportado!" << std::endl;
         return cv::Mat();
     }
 
-    return result;
+    return invert_lut().apply(img);
+}
+
+PointLut ChannelIsolator::invert_lut()
+{
+    PointLut::Table table;
+    for (int v = 0; v < 256; v++)
+    {
+        table[v] = static_cast<uchar>(255 - v);
+    }
+    return PointLut(table);
 }
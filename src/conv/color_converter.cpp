@@ -0,0 +1,497 @@
+#include "conv/color_converter.hpp"
+#include "conv/bgr_simd.hpp"
+#include "conv/srgb_tables.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+    /**
+     * Kernel que converte uma linha de `cols` pixels de 3 canais.
+     */
+    typedef void (*RowKernel)(const uchar* in, uchar* out, int cols);
+
+    /**
+     * Aplica o kernel a todas as linhas, divididas entre threads.
+     */
+    cv::Mat convert_rows_parallel(const cv::Mat& img, RowKernel kernel)
+    {
+        cv::Mat result(img.rows, img.cols, CV_8UC3);
+        cv::parallel_for_(cv::Range(0, img.rows), [&](const cv::Range& faixa)
+        {
+            for (int linha = faixa.start; linha < faixa.end; linha++)
+            {
+                kernel(img.ptr<uchar>(linha), result.ptr<uchar>(linha), img.cols);
+            }
+        });
+        return result;
+    }
+
+    inline uchar saturate_u8(int v)
+    {
+        return static_cast<uchar>(std::min(std::max(v, 0), 255));
+    }
+
+    inline uchar saturate_u8(float v)
+    {
+        return saturate_u8(static_cast<int>(std::lround(v)));
+    }
+
+    // ================ YCrCb (Q14, coeficientes do OpenCV) ================
+
+    const int YCC_SHIFT = 14;
+    const int YCC_HALF = 1 << (YCC_SHIFT - 1);
+    const int B2Y = 1868;
+    const int G2Y = 9617;
+    const int R2Y = 4899;
+    const int R2CR = 11682;     // 0.713
+    const int B2CB = 9241;      // 0.564
+    const int CR2R = 22987;     // 1.403
+    const int CR2G = -11698;    // -0.714
+    const int CB2G = -5636;     // -0.344
+    const int CB2B = 29049;     // 1.773
+
+    /**
+     * Referência escalar: Y arredondado e reutilizado em Cr e Cb, como no
+     * OpenCV; o deslocamento aritmético (>>) arredonda para baixo também
+     * nas diferenças negativas.
+     */
+    inline void ycrcb_pixel(const uchar* p, uchar* q)
+    {
+        const int y = (p[0] * B2Y + p[1] * G2Y + p[2] * R2Y + YCC_HALF) >> YCC_SHIFT;
+        q[0] = static_cast<uchar>(y);
+        q[1] = saturate_u8((((p[2] - y) * R2CR + YCC_HALF) >> YCC_SHIFT) + 128);
+        q[2] = saturate_u8((((p[0] - y) * B2CB + YCC_HALF) >> YCC_SHIFT) + 128);
+    }
+
+    inline void ycrcb_to_bgr_pixel(const uchar* p, uchar* q)
+    {
+        const int y = p[0];
+        const int cr = p[1] - 128;
+        const int cb = p[2] - 128;
+        q[0] = saturate_u8(y + ((cb * CB2B + YCC_HALF) >> YCC_SHIFT));
+        q[1] = saturate_u8(y + ((cb * CB2G + cr * CR2G + YCC_HALF) >> YCC_SHIFT));
+        q[2] = saturate_u8(y + ((cr * CR2R + YCC_HALF) >> YCC_SHIFT));
+    }
+
+#if defined(BGR_SIMD_SSSE3)
+    /**
+     * Combinação linear de 8 pares de 16 bits (x0, x1) com (c0, c1) em
+     * 32 bits (pmaddwd), com arredondamento e deslocamento Q14 aritmético;
+     * devolve 8 valores de 16 bits com sinal.
+     */
+    inline __m128i madd_q14(__m128i x0, __m128i x1, __m128i coeffs)
+    {
+        const __m128i half = _mm_set1_epi32(YCC_HALF);
+        const __m128i lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), coeffs), half), YCC_SHIFT);
+        const __m128i hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(x0, x1), coeffs), half), YCC_SHIFT);
+        return _mm_packs_epi32(lo, hi);
+    }
+
+    inline __m128i pair_coeffs(int c0, int c1)
+    {
+        return _mm_set1_epi32((static_cast<int>(static_cast<uint16_t>(c1)) << 16) | static_cast<uint16_t>(c0));
+    }
+#endif
+
+    void bgr_to_ycrcb_row(const uchar* in, uchar* out, int cols)
+    {
+        int coluna = 0;
+#if defined(BGR_SIMD_SSSE3)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bias = _mm_set1_epi16(128);
+            const __m128i w_bg = pair_coeffs(B2Y, G2Y);
+            const __m128i w_r = pair_coeffs(R2Y, 0);
+            const __m128i w_cr = pair_coeffs(R2CR, 0);
+            const __m128i w_cb = pair_coeffs(B2CB, 0);
+            for (; coluna + 16 <= cols; coluna += 16)
+            {
+                __m128i b, g, r;
+                bgr_simd::deinterleave_bgr_128(in + 3 * coluna, b, g, r);
+                __m128i planes[3][2];
+                for (int metade = 0; metade < 2; metade++)
+                {
+                    const __m128i b16 = metade ? _mm_unpackhi_epi8(b, zero) : _mm_unpacklo_epi8(b, zero);
+                    const __m128i g16 = metade ? _mm_unpackhi_epi8(g, zero) : _mm_unpacklo_epi8(g, zero);
+                    const __m128i r16 = metade ? _mm_unpackhi_epi8(r, zero) : _mm_unpacklo_epi8(r, zero);
+                    // Y = (wB*B + wG*G) + (wR*R + 0*0), arredondado em Q14
+                    const __m128i half = _mm_set1_epi32(YCC_HALF);
+                    const __m128i y_lo = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(
+                        _mm_madd_epi16(_mm_unpacklo_epi16(b16, g16), w_bg),
+                        _mm_madd_epi16(_mm_unpacklo_epi16(r16, zero), w_r)), half), YCC_SHIFT);
+                    const __m128i y_hi = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(
+                        _mm_madd_epi16(_mm_unpackhi_epi16(b16, g16), w_bg),
+                        _mm_madd_epi16(_mm_unpackhi_epi16(r16, zero), w_r)), half), YCC_SHIFT);
+                    const __m128i y16 = _mm_packs_epi32(y_lo, y_hi);
+                    planes[0][metade] = y16;
+                    planes[1][metade] = _mm_add_epi16(madd_q14(_mm_sub_epi16(r16, y16), zero, w_cr), bias);
+                    planes[2][metade] = _mm_add_epi16(madd_q14(_mm_sub_epi16(b16, y16), zero, w_cb), bias);
+                }
+                bgr_simd::interleave_bgr_128(_mm_packus_epi16(planes[0][0], planes[0][1]),
+                                             _mm_packus_epi16(planes[1][0], planes[1][1]),
+                                             _mm_packus_epi16(planes[2][0], planes[2][1]), out + 3 * coluna);
+            }
+        }
+#endif
+        for (; coluna < cols; coluna++)
+        {
+            ycrcb_pixel(in + 3 * coluna, out + 3 * coluna);
+        }
+    }
+
+    void ycrcb_to_bgr_row(const uchar* in, uchar* out, int cols)
+    {
+        int coluna = 0;
+#if defined(BGR_SIMD_SSSE3)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bias = _mm_set1_epi16(128);
+            const __m128i w_b = pair_coeffs(CB2B, 0);
+            const __m128i w_g = pair_coeffs(CB2G, CR2G);
+            const __m128i w_r = pair_coeffs(CR2R, 0);
+            for (; coluna + 16 <= cols; coluna += 16)
+            {
+                __m128i y, cr, cb;
+                bgr_simd::deinterleave_bgr_128(in + 3 * coluna, y, cr, cb);
+                __m128i planes[3][2];
+                for (int metade = 0; metade < 2; metade++)
+                {
+                    const __m128i y16 = metade ? _mm_unpackhi_epi8(y, zero) : _mm_unpacklo_epi8(y, zero);
+                    const __m128i cr16 = _mm_sub_epi16(metade ? _mm_unpackhi_epi8(cr, zero) : _mm_unpacklo_epi8(cr, zero), bias);
+                    const __m128i cb16 = _mm_sub_epi16(metade ? _mm_unpackhi_epi8(cb, zero) : _mm_unpacklo_epi8(cb, zero), bias);
+                    planes[0][metade] = _mm_add_epi16(y16, madd_q14(cb16, zero, w_b));
+                    planes[1][metade] = _mm_add_epi16(y16, madd_q14(cb16, cr16, w_g));
+                    planes[2][metade] = _mm_add_epi16(y16, madd_q14(cr16, zero, w_r));
+                }
+                bgr_simd::interleave_bgr_128(_mm_packus_epi16(planes[0][0], planes[0][1]),
+                                             _mm_packus_epi16(planes[1][0], planes[1][1]),
+                                             _mm_packus_epi16(planes[2][0], planes[2][1]), out + 3 * coluna);
+            }
+        }
+#endif
+        for (; coluna < cols; coluna++)
+        {
+            ycrcb_to_bgr_pixel(in + 3 * coluna, out + 3 * coluna);
+        }
+    }
+
+    // ================ HSV ================
+
+    /**
+     * Tabelas do HSV de 8 bits (mesmas do OpenCV, Q12):
+     * sdiv[v] = 255 / v e hdiv[d] = 180 / (6 * d) para a conversão direta;
+     * sector/fraction decompõem cada H em setor de 60 graus e fração para
+     * a conversão inversa.
+     */
+    struct HsvTables
+    {
+        static constexpr int SHIFT = 12;
+
+        int sdiv[256];
+        int hdiv[256];
+        int sector[256];
+        float fraction[256];
+
+        HsvTables()
+        {
+            sdiv[0] = 0;
+            hdiv[0] = 0;
+            for (int i = 1; i < 256; i++)
+            {
+                sdiv[i] = static_cast<int>(std::lround((255 << SHIFT) / static_cast<double>(i)));
+                hdiv[i] = static_cast<int>(std::lround((180 << SHIFT) / (6.0 * i)));
+            }
+
+            for (int h = 0; h < 256; h++)
+            {
+                float scaled = h * (6.0f / 180.0f);
+                while (scaled >= 6.0f)
+                {
+                    scaled -= 6.0f;
+                }
+                sector[h] = static_cast<int>(std::floor(scaled));
+                fraction[h] = scaled - sector[h];
+            }
+        }
+    };
+
+    const HsvTables& hsv_tables()
+    {
+        static const HsvTables tables;
+        return tables;
+    }
+
+    void bgr_to_hsv_row(const uchar* in, uchar* out, int cols)
+    {
+        const HsvTables& tables = hsv_tables();
+        const int half = 1 << (HsvTables::SHIFT - 1);
+
+        for (int coluna = 0; coluna < cols; coluna++)
+        {
+            const uchar* p = in + 3 * coluna;
+            const int b = p[0];
+            const int g = p[1];
+            const int r = p[2];
+            const int v = std::max(b, std::max(g, r));
+            const int diff = v - std::min(b, std::min(g, r));
+
+            int h;
+            if (v == r)
+            {
+                h = g - b;
+            }
+            else if (v == g)
+            {
+                h = b - r + 2 * diff;
+            }
+            else
+            {
+                h = r - g + 4 * diff;
+            }
+            h = (h * tables.hdiv[diff] + half) >> HsvTables::SHIFT;
+            if (h < 0)
+            {
+                h += 180;
+            }
+
+            uchar* q = out + 3 * coluna;
+            q[0] = static_cast<uchar>(h);
+            q[1] = static_cast<uchar>((diff * tables.sdiv[v] + half) >> HsvTables::SHIFT);
+            q[2] = static_cast<uchar>(v);
+        }
+    }
+
+    void hsv_to_bgr_row(const uchar* in, uchar* out, int cols)
+    {
+        // Para cada setor: índices em {v, p, q, t} de B, G e R
+        static const int SECTOR_DATA[6][3] = { { 1, 3, 0 }, { 1, 0, 2 }, { 3, 0, 1 },
+                                               { 0, 2, 1 }, { 0, 1, 3 }, { 2, 1, 0 } };
+        const HsvTables& tables = hsv_tables();
+
+        for (int coluna = 0; coluna < cols; coluna++)
+        {
+            const uchar* p = in + 3 * coluna;
+            uchar* q = out + 3 * coluna;
+            const float s = p[1] * (1.0f / 255.0f);
+            const float v = p[2] * (1.0f / 255.0f);
+
+            if (s == 0.0f)
+            {
+                q[0] = q[1] = q[2] = p[2];
+                continue;
+            }
+
+            const float h = tables.fraction[p[0]];
+            const float tab[4] = { v, v * (1.0f - s), v * (1.0f - s * h), v * (1.0f - s + s * h) };
+            const int* index = SECTOR_DATA[tables.sector[p[0]]];
+            q[0] = saturate_u8(tab[index[0]] * 255.0f);
+            q[1] = saturate_u8(tab[index[1]] * 255.0f);
+            q[2] = saturate_u8(tab[index[2]] * 255.0f);
+        }
+    }
+
+    // ================ CIE Lab (D65) ================
+
+    /**
+     * Tabelas do Lab:
+     * - srgb: linearização e recodificação sRGB compartilhadas (srgb_tables.hpp)
+     * - cbrt: f(t) do Lab amostrada em CBRT_SIZE intervalos de [0, 1]
+     *   (interpolação linear; erro < 0,001 em L)
+     */
+    struct LabTables
+    {
+        static constexpr int CBRT_SIZE = 1024;
+
+        const srgb::Tables& srgb;
+        float cbrt[CBRT_SIZE + 2];
+
+        LabTables()
+            : srgb(srgb::tables())
+        {
+            for (int i = 0; i <= CBRT_SIZE + 1; i++)
+            {
+                cbrt[i] = static_cast<float>(lab_f(static_cast<double>(i) / CBRT_SIZE));
+            }
+        }
+
+        static double lab_f(double t)
+        {
+            return (t > 0.008856) ? std::cbrt(t) : 7.787 * t + 16.0 / 116.0;
+        }
+
+        float f(float t) const
+        {
+            const float position = std::min(std::max(t, 0.0f), 1.0f) * CBRT_SIZE;
+            const int index = static_cast<int>(position);
+            return cbrt[index] + (cbrt[index + 1] - cbrt[index]) * (position - index);
+        }
+
+        uchar to_srgb(float linear_value) const
+        {
+            const float clamped = std::min(std::max(linear_value, 0.0f), 1.0f);
+            return srgb.encode[static_cast<int>(clamped * 65535.0f + 0.5f)];
+        }
+    };
+
+    const LabTables& lab_tables()
+    {
+        static const LabTables tables;
+        return tables;
+    }
+
+    // Branco de referência D65
+    const float WHITE_X = 0.950456f;
+    const float WHITE_Z = 1.088754f;
+
+    void bgr_to_lab_row(const uchar* in, uchar* out, int cols)
+    {
+        const LabTables& tables = lab_tables();
+
+        for (int coluna = 0; coluna < cols; coluna++)
+        {
+            const uchar* p = in + 3 * coluna;
+            const float b = tables.srgb.linear[p[0]];
+            const float g = tables.srgb.linear[p[1]];
+            const float r = tables.srgb.linear[p[2]];
+
+            // sRGB linear -> XYZ, normalizado pelo branco
+            const float x = (0.412453f * r + 0.357580f * g + 0.180423f * b) / WHITE_X;
+            const float y = 0.212671f * r + 0.715160f * g + 0.072169f * b;
+            const float z = (0.019334f * r + 0.119193f * g + 0.950227f * b) / WHITE_Z;
+
+            const float fx = tables.f(x);
+            const float fy = tables.f(y);
+            const float fz = tables.f(z);
+
+            uchar* q = out + 3 * coluna;
+            q[0] = saturate_u8((116.0f * fy - 16.0f) * (255.0f / 100.0f));
+            q[1] = saturate_u8(500.0f * (fx - fy) + 128.0f);
+            q[2] = saturate_u8(200.0f * (fy - fz) + 128.0f);
+        }
+    }
+
+    inline float lab_f_inverse(float f)
+    {
+        return (f > 6.0f / 29.0f) ? f * f * f : (f - 16.0f / 116.0f) / 7.787f;
+    }
+
+    void lab_to_bgr_row(const uchar* in, uchar* out, int cols)
+    {
+        const LabTables& tables = lab_tables();
+
+        for (int coluna = 0; coluna < cols; coluna++)
+        {
+            const uchar* p = in + 3 * coluna;
+            const float l = p[0] * (100.0f / 255.0f);
+            const float a = p[1] - 128.0f;
+            const float bb = p[2] - 128.0f;
+
+            // Trecho linear de f perto do preto (L <= 903.3 * 0.008856)
+            float y;
+            float fy;
+            if (l <= 7.9996f)
+            {
+                y = l / 903.3f;
+                fy = 7.787f * y + 16.0f / 116.0f;
+            }
+            else
+            {
+                fy = (l + 16.0f) / 116.0f;
+                y = fy * fy * fy;
+            }
+            const float x = lab_f_inverse(fy + a / 500.0f) * WHITE_X;
+            const float z = lab_f_inverse(fy - bb / 200.0f) * WHITE_Z;
+
+            // XYZ -> sRGB linear
+            const float r = 3.240479f * x - 1.537150f * y - 0.498535f * z;
+            const float g = -0.969256f * x + 1.875991f * y + 0.041556f * z;
+            const float b = 0.055648f * x - 0.204043f * y + 1.057311f * z;
+
+            uchar* q = out + 3 * coluna;
+            q[0] = tables.to_srgb(b);
+            q[1] = tables.to_srgb(g);
+            q[2] = tables.to_srgb(r);
+        }
+    }
+}
+
+ColorConverter::ColorConverter()
+{
+}
+
+ColorConverter::~ColorConverter()
+{
+}
+
+bool ColorConverter::is_valid_image(const cv::Mat& img)
+{
+    if (img.empty() || img.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ter 3 canais de 8 bits (CV_8UC3)!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ================ YCbCr ================
+
+cv::Mat ColorConverter::bgr_to_ycrcb(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, bgr_to_ycrcb_row);
+}
+
+cv::Mat ColorConverter::ycrcb_to_bgr(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, ycrcb_to_bgr_row);
+}
+
+// ================ HSV ================
+
+cv::Mat ColorConverter::bgr_to_hsv(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, bgr_to_hsv_row);
+}
+
+cv::Mat ColorConverter::hsv_to_bgr(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, hsv_to_bgr_row);
+}
+
+// ================ CIE Lab ================
+
+cv::Mat ColorConverter::bgr_to_lab(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, bgr_to_lab_row);
+}
+
+cv::Mat ColorConverter::lab_to_bgr(const cv::Mat& img)
+{
+    if (!is_valid_image(img))
+    {
+        return cv::Mat();
+    }
+    return convert_rows_parallel(img, lab_to_bgr_row);
+}
@@ -1,14 +1,466 @@
 #include "conv/grayscale.hpp"
+#include "conv/bgr_simd.hpp"
+#include "conv/srgb_tables.hpp"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+#if defined(BGR_SIMD_SSSE3)
+    using bgr_simd::deinterleave_bgr_128;
+#endif
+#if defined(__AVX2__)
+    using bgr_simd::deinterleave_bgr_256;
+#endif
+
+    /**
+     * Pesos Q15 (soma 32768) da média ponderada.
+     */
+    struct GrayWeights
+    {
+        int b;
+        int g;
+        int r;
+    };
+
+    GrayWeights weights_for(GrayScale::GrayStandard standard)
+    {
+        if (standard == GrayScale::BT709)
+        {
+            return GrayWeights{ 2366, 23436, 6966 };
+        }
+        return GrayWeights{ 3735, 19235, 9798 };
+    }
+
+    // Multiplicador de (B + G + R) / 3 em Q16: 21846 / 65536 ~= 1 / 3
+    const int MEAN_MULTIPLIER = 21846;
+
+    /**
+     * Referência escalar da média ponderada (arredondamento: metade para cima).
+     */
+    inline uchar weighted_pixel(const uchar* p, const GrayWeights& w)
+    {
+        return static_cast<uchar>((w.b * p[0] + w.g * p[1] + w.r * p[2] + (1 << 14)) >> 15);
+    }
+
+    /**
+     * Referência escalar da média aritmética (truncada).
+     */
+    inline uchar mean_pixel(const uchar* p)
+    {
+        return static_cast<uchar>(((p[0] + p[1] + p[2]) * MEAN_MULTIPLIER) >> 16);
+    }
+
+#if defined(BGR_SIMD_SSSE3)
+    /**
+     * Média ponderada de 8 pixels em 16 bits: pares (B, G) e (R, 1) somados
+     * por pmaddwd com (wB, wG) e (wR, 2^14) -> soma arredondada em 32 bits.
+     */
+    inline __m128i weighted_8x16(__m128i b, __m128i g, __m128i r, __m128i w_bg, __m128i w_r1)
+    {
+        const __m128i one = _mm_set1_epi16(1);
+        __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(b, g), w_bg),
+                                   _mm_madd_epi16(_mm_unpacklo_epi16(r, one), w_r1));
+        __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(b, g), w_bg),
+                                   _mm_madd_epi16(_mm_unpackhi_epi16(r, one), w_r1));
+        return _mm_packs_epi32(_mm_srli_epi32(lo, 15), _mm_srli_epi32(hi, 15));
+    }
+#endif
+
+#if defined(__AVX2__)
+    inline __m256i weighted_16x16(__m256i b, __m256i g, __m256i r, __m256i w_bg, __m256i w_r1)
+    {
+        const __m256i one = _mm256_set1_epi16(1);
+        __m256i lo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(b, g), w_bg),
+                                      _mm256_madd_epi16(_mm256_unpacklo_epi16(r, one), w_r1));
+        __m256i hi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(b, g), w_bg),
+                                      _mm256_madd_epi16(_mm256_unpackhi_epi16(r, one), w_r1));
+        return _mm256_packs_epi32(_mm256_srli_epi32(lo, 15), _mm256_srli_epi32(hi, 15));
+    }
+#endif
+
+    /**
+     * Calcula a média ponderada de `count` pixels BGR consecutivos em
+     * registradores e entrega cada bloco ao consumidor `sink`, que decide o
+     * que fazer com os níveis de cinza (gravar, limiarizar, contar...), sem
+     * imagem intermediária. O consumidor implementa put(i, v) para blocos de
+     * 32 pixels (__m256i, AVX2), 16 pixels (__m128i, SSSE3) e pixel isolado.
+     * As operações de unpack/pack atuam por metade de 128 bits e preservam a
+     * ordem dos pixels; o resultado é idêntico ao de weighted_pixel.
+     */
+    template <typename Sink>
+    void weighted_apply(const uchar* in, size_t count, const GrayWeights& w, Sink& sink)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i w_bg = _mm256_set1_epi32((w.g << 16) | w.b);
+            const __m256i w_r1 = _mm256_set1_epi32(((1 << 14) << 16) | w.r);
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i b, g, r;
+                deinterleave_bgr_256(in + 3 * i, b, g, r);
+                __m256i lo = weighted_16x16(_mm256_unpacklo_epi8(b, zero), _mm256_unpacklo_epi8(g, zero),
+                                            _mm256_unpacklo_epi8(r, zero), w_bg, w_r1);
+                __m256i hi = weighted_16x16(_mm256_unpackhi_epi8(b, zero), _mm256_unpackhi_epi8(g, zero),
+                                            _mm256_unpackhi_epi8(r, zero), w_bg, w_r1);
+                sink.put(i, _mm256_packus_epi16(lo, hi));
+            }
+        }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i w_bg = _mm_set1_epi32((w.g << 16) | w.b);
+            const __m128i w_r1 = _mm_set1_epi32(((1 << 14) << 16) | w.r);
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i b, g, r;
+                deinterleave_bgr_128(in + 3 * i, b, g, r);
+                __m128i lo = weighted_8x16(_mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(g, zero),
+                                           _mm_unpacklo_epi8(r, zero), w_bg, w_r1);
+                __m128i hi = weighted_8x16(_mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(g, zero),
+                                           _mm_unpackhi_epi8(r, zero), w_bg, w_r1);
+                sink.put(i, _mm_packus_epi16(lo, hi));
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            sink.put(i, weighted_pixel(in + 3 * i, w));
+        }
+    }
+
+    /**
+     * Consumidor que grava os níveis de cinza (conversão comum).
+     */
+    struct StoreSink
+    {
+        uchar* out;
+
+#if defined(__AVX2__)
+        void put(size_t i, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v); }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        void put(size_t i, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v); }
+#endif
+        void put(size_t i, uchar v) { out[i] = v; }
+    };
+
+    /**
+     * Consumidor que grava a máscara binária: gray > limiar -> max_value
+     * (ou o inverso). Comparação sem sinal via min: gray <= limiar
+     * equivale a min(gray, limiar) == gray.
+     */
+    struct ThresholdSink
+    {
+        uchar* out;
+        uchar threshold_value;
+        uchar max_value;
+        bool inverted;
+
+#if defined(__AVX2__)
+        void put(size_t i, __m256i v)
+        {
+            const __m256i below = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(static_cast<char>(threshold_value))), v);
+            const __m256i value = _mm256_set1_epi8(static_cast<char>(max_value));
+            const __m256i mask = inverted ? _mm256_and_si256(below, value) : _mm256_andnot_si256(below, value);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mask);
+        }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        void put(size_t i, __m128i v)
+        {
+            const __m128i below = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(static_cast<char>(threshold_value))), v);
+            const __m128i value = _mm_set1_epi8(static_cast<char>(max_value));
+            const __m128i mask = inverted ? _mm_and_si128(below, value) : _mm_andnot_si128(below, value);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), mask);
+        }
+#endif
+        void put(size_t i, uchar v)
+        {
+            out[i] = ((v > threshold_value) != inverted) ? max_value : 0;
+        }
+    };
+
+    /**
+     * Consumidor que conta os níveis de cinza. Os blocos são acumulados em um
+     * buffer pequeno (fica no cache L1) e contados em lote, em 4
+     * sub-histogramas intercalados (evita dependência entre incrementos do
+     * mesmo bin); o laço de contagem fica separado do de conversão, que
+     * assim não disputa as mesmas unidades a cada bloco.
+     * flush() deve ser chamado ao final para contar o que restou.
+     */
+    struct HistogramSink
+    {
+        static constexpr size_t CAPACITY = 1024;
+
+        uint32_t (*counts)[256];
+        size_t filled = 0;
+        alignas(32) uchar pending[CAPACITY];
+
+        explicit HistogramSink(uint32_t (*target)[256]) : counts(target)
+        {
+        }
+
+        void flush()
+        {
+            size_t k = 0;
+            for (; k + 4 <= filled; k += 4)
+            {
+                counts[0][pending[k]]++;
+                counts[1][pending[k + 1]]++;
+                counts[2][pending[k + 2]]++;
+                counts[3][pending[k + 3]]++;
+            }
+            for (; k < filled; k++)
+            {
+                counts[0][pending[k]]++;
+            }
+            filled = 0;
+        }
+
+#if defined(__AVX2__)
+        void put(size_t, __m256i v)
+        {
+            if (filled + 32 > CAPACITY) flush();
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pending + filled), v);
+            filled += 32;
+        }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        void put(size_t, __m128i v)
+        {
+            if (filled + 16 > CAPACITY) flush();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pending + filled), v);
+            filled += 16;
+        }
+#endif
+        void put(size_t, uchar v)
+        {
+            if (filled == CAPACITY) flush();
+            pending[filled++] = v;
+        }
+    };
+
+    /**
+     * Encaminha cada bloco a dois consumidores (ex.: máscara + histograma).
+     */
+    template <typename First, typename Second>
+    struct PairSink
+    {
+        First& first;
+        Second& second;
+
+        template <typename Block>
+        void put(size_t i, Block v)
+        {
+            first.put(i, v);
+            second.put(i, v);
+        }
+    };
+
+    /**
+     * Média ponderada de `count` pixels BGR consecutivos.
+     */
+    void weighted_span(const uchar* in, uchar* out, size_t count, const GrayWeights& w)
+    {
+        StoreSink sink{ out };
+        weighted_apply(in, count, w, sink);
+    }
+    /**
+     * Média aritmética de `count` pixels BGR consecutivos:
+     * soma em 16 bits e pmulhuw pelo multiplicador Q16.
+     */
+    void mean_span(const uchar* in, uchar* out, size_t count)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i multiplier = _mm256_set1_epi16(static_cast<short>(MEAN_MULTIPLIER));
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i b, g, r;
+                deinterleave_bgr_256(in + 3 * i, b, g, r);
+                __m256i lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpacklo_epi8(b, zero), _mm256_unpacklo_epi8(g, zero)),
+                                              _mm256_unpacklo_epi8(r, zero));
+                __m256i hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpackhi_epi8(b, zero), _mm256_unpackhi_epi8(g, zero)),
+                                              _mm256_unpackhi_epi8(r, zero));
+                lo = _mm256_mulhi_epu16(lo, multiplier);
+                hi = _mm256_mulhi_epu16(hi, multiplier);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(lo, hi));
+            }
+        }
+#endif
+#if defined(BGR_SIMD_SSSE3)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i multiplier = _mm_set1_epi16(static_cast<short>(MEAN_MULTIPLIER));
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i b, g, r;
+                deinterleave_bgr_128(in + 3 * i, b, g, r);
+                __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(g, zero)),
+                                           _mm_unpacklo_epi8(r, zero));
+                __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(g, zero)),
+                                           _mm_unpackhi_epi8(r, zero));
+                lo = _mm_mulhi_epu16(lo, multiplier);
+                hi = _mm_mulhi_epu16(hi, multiplier);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            out[i] = mean_pixel(in + 3 * i);
+        }
+    }
+
+    /**
+     * Média ponderada em luz linear de `count` pixels BGR: decodifica cada
+     * canal por tabela, pondera em 32 bits com os pesos Q15 e recodifica.
+     * Fórmula: gray = encode[(wB*L[B] + wG*L[G] + wR*L[R] + 16384) >> 15]
+     * Soma máxima 32768 * 65535 < 2^31: cabe em inteiros de 32 bits.
+     */
+    void linear_span(const uchar* in, uchar* out, size_t count, const GrayWeights& w)
+    {
+        const srgb::Tables& tables = srgb::tables();
+        size_t i = 0;
+#if defined(__AVX2__)
+        {
+            const int* decode = reinterpret_cast<const int*>(tables.decode);
+            const int* encode = reinterpret_cast<const int*>(tables.encode);
+            const __m256i w_b = _mm256_set1_epi32(w.b);
+            const __m256i w_g = _mm256_set1_epi32(w.g);
+            const __m256i w_r = _mm256_set1_epi32(w.r);
+            const __m256i half = _mm256_set1_epi32(1 << 14);
+            const __m256i low_byte = _mm256_set1_epi32(0xFF);
+            const __m256i pack_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+            // 8 pixels: índices de 32 bits -> gather linear -> soma -> gather sRGB
+            auto luma_8 = [&](__m128i b8, __m128i g8, __m128i r8)
+            {
+                __m256i y = _mm256_mullo_epi32(_mm256_i32gather_epi32(decode, _mm256_cvtepu8_epi32(b8), 4), w_b);
+                y = _mm256_add_epi32(y, _mm256_mullo_epi32(_mm256_i32gather_epi32(decode, _mm256_cvtepu8_epi32(g8), 4), w_g));
+                y = _mm256_add_epi32(y, _mm256_mullo_epi32(_mm256_i32gather_epi32(decode, _mm256_cvtepu8_epi32(r8), 4), w_r));
+                y = _mm256_srli_epi32(_mm256_add_epi32(y, half), 15);
+                return _mm256_and_si256(_mm256_i32gather_epi32(encode, y, 1), low_byte);
+            };
+
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i b, g, r;
+                deinterleave_bgr_256(in + 3 * i, b, g, r);
+                __m256i y[4];
+                for (int half_index = 0; half_index < 2; half_index++)
+                {
+                    const __m128i b16 = half_index ? _mm256_extracti128_si256(b, 1) : _mm256_castsi256_si128(b);
+                    const __m128i g16 = half_index ? _mm256_extracti128_si256(g, 1) : _mm256_castsi256_si128(g);
+                    const __m128i r16 = half_index ? _mm256_extracti128_si256(r, 1) : _mm256_castsi256_si128(r);
+                    y[2 * half_index] = luma_8(b16, g16, r16);
+                    y[2 * half_index + 1] = luma_8(_mm_srli_si128(b16, 8), _mm_srli_si128(g16, 8), _mm_srli_si128(r16, 8));
+                }
+                // packus atua por metade de 128 bits; a permutação final
+                // restaura a ordem dos 32 pixels
+                const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(y[0], y[1]), _mm256_packus_epi32(y[2], y[3]));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permutevar8x32_epi32(packed, pack_order));
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            const uchar* p = in + 3 * i;
+            const uint32_t y = (w.b * tables.decode[p[0]] + w.g * tables.decode[p[1]] +
+                                w.r * tables.decode[p[2]] + (1u << 14)) >> 15;
+            out[i] = tables.encode[y];
+        }
+    }
+
+    /**
+     * Converte `count` pixels BGR consecutivos pelo método escolhido.
+     */
+    void convert_span(const uchar* in, uchar* out, size_t count, GrayScale::GrayMethod method, const GrayWeights& w)
+    {
+        if (method == GrayScale::ARITHMETIC)
+        {
+            mean_span(in, out, count);
+        }
+        else if (method == GrayScale::LINEAR)
+        {
+            linear_span(in, out, count, w);
+        }
+        else
+        {
+            weighted_span(in, out, count, w);
+        }
+    }
+
+    /**
+     * Passada fundida sobre a imagem BGR, em faixas de linhas paralelas: os
+     * níveis de cinza ficam em registradores e geram a máscara binária (se
+     * mask != nullptr) e/ou as contagens do histograma (se histogram !=
+     * nullptr). Cada faixa conta em sub-histogramas privados; só a soma
+     * final é feita sob exclusão mútua.
+     */
+    void fused_weighted_pass(const cv::Mat& input, cv::Mat* mask, uchar threshold_value, uchar max_value,
+                             bool inverted, uint32_t* histogram, const GrayWeights& w)
+    {
+        std::mutex merge_mutex;
+        cv::parallel_for_(cv::Range(0, input.rows), [&](const cv::Range& faixa)
+        {
+            uint32_t local[4][256] = {};
+            HistogramSink counter(local);
+            const size_t cols = static_cast<size_t>(input.cols);
+
+            for (int linha = faixa.start; linha < faixa.end; linha++)
+            {
+                const uchar* in = input.ptr<uchar>(linha);
+                if (mask == nullptr)
+                {
+                    weighted_apply(in, cols, w, counter);
+                    continue;
+                }
+
+                ThresholdSink binarizer{ mask->ptr<uchar>(linha), threshold_value, max_value, inverted };
+                if (histogram != nullptr)
+                {
+                    PairSink<ThresholdSink, HistogramSink> both{ binarizer, counter };
+                    weighted_apply(in, cols, w, both);
+                }
+                else
+                {
+                    weighted_apply(in, cols, w, binarizer);
+                }
+            }
+
+            if (histogram == nullptr)
+            {
+                return;
+            }
+
+            counter.flush();
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            for (int v = 0; v < 256; v++)
+            {
+                histogram[v] += local[0][v] + local[1][v] + local[2][v] + local[3][v];
+            }
+        }, cv::getNumThreads());
+    }
+}
+
+GrayScale::GrayScale()
+{
+}
 
 GrayScale::GrayScale(const cv::Mat& img1)
 {
     // Guarda a referência matricial de entrada.
     // Observação: cv::Mat utiliza contagem de referência; cópia é “shallow”.
     img1_ = img1;
-
-    // Inicializa o buffer de saída (mesmas dimensões, 1 canal de 8 bits).
-    // Pré-condição implícita: img1 deve possuir rows/cols > 0.
-    result = cv::Mat(img1.rows, img1.cols, CV_8UC(1));
 }
 
 /**
@@ -18,61 +470,77 @@ GrayScale::GrayScale(const cv::Mat& img1)
  * Observações:
  * - Esta estratégia é suficiente para fins didáticos; para melhor aderência à
  *   luminância humana, considere get_gray_weighted().
- * - O acesso a pixels é feito por ponteiros de linha (ptr) para eficiência.
+ * - A divisão por 3 é feita por multiplicação em ponto fixo (Q16), com o
+ *   mesmo resultado da divisão inteira.
+ * - Imagens contínuas são processadas como uma única sequência de pixels.
  */
 cv::Mat GrayScale::get_gray_arithmetic()
 {
-    for (int linha = 0; linha < img1_.rows; linha++)
-    {
-        // Linha de entrada (3 canais, BGR)
-        cv::Vec3b* pixel__in = img1_.ptr<cv::Vec3b>(linha);
-        // Linha de saída (1 canal)
-        uchar* pixel_out = result.ptr<uchar>(linha);
-
-        for (int coluna = 0; coluna < img1_.cols; coluna++)
-        {
-            // Média simples dos três canais (conversão para uchar explicitamente).
-            pixel_out[coluna] = static_cast<uchar>(
-                (
-                    pixel__in[coluna][0] +
-                    pixel__in[coluna][1] +
-                    pixel__in[coluna][2]
-                    ) / 3
-                );
-        }
-    }
+    cv::Mat result;
+    convert(img1_, result, ARITHMETIC);
     return result;
 }
 
 /**
- * Converte a imagem BGR em tons de cinza por média ponderada (padrão ITU-R BT.709).
- * Fórmula: gray = 0.114*B + 0.587*G + 0.299*R
+ * Converte a imagem BGR em tons de cinza por média ponderada.
+ * Fórmula (BT.601): gray = 0.114*B + 0.587*G + 0.299*R
  *
  * Observações:
  * - Esta fórmula considera a percepção humana da luminância.
  * - O verde tem maior peso devido à sensibilidade do olho humano.
- * - Clamping para evitar overflow/underflow.
+ * - Pesos Q15 com soma 32768: o resultado nunca passa de 255, dispensando
+ *   o clamping da versão em double.
  */
-cv::Mat GrayScale::get_gray_weighted()
+cv::Mat GrayScale::get_gray_weighted(GrayStandard standard)
 {
-    for (int linha = 0; linha < img1_.rows; linha++)
+    cv::Mat result;
+    convert(img1_, result, WEIGHTED, standard);
+    return result;
+}
+
+/**
+ * Converte a imagem BGR em tons de cinza por média ponderada em luz linear.
+ * Cada canal sRGB é decodificado por tabela para 16 bits lineares, ponderado
+ * e recodificado para sRGB por uma segunda tabela (64 KB).
+ */
+cv::Mat GrayScale::get_gray_linear(GrayStandard standard)
+{
+    cv::Mat result;
+    convert(img1_, result, LINEAR, standard);
+    return result;
+}
+
+/**
+ * Conversão ponderada com histograma fundido.
+ * Cada bloco de pixels é gravado e contado a partir do mesmo registrador,
+ * de modo que a imagem cinza não precisa ser relida da memória.
+ */
+cv::Mat GrayScale::get_gray_weighted_histogram(std::vector<int>& histogram, GrayStandard standard)
+{
+    histogram.assign(256, 0);
+    const GrayWeights weights = weights_for(standard);
+
+    if (img1_.empty() || img1_.type() != CV_8UC3)
     {
-        // Linha de entrada (3 canais, BGR)
-        cv::Vec3b* pixel__in = img1_.ptr<cv::Vec3b>(linha);
-        // Linha de saída (1 canal)
-        uchar* pixel_out = result.ptr<uchar>(linha);
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return cv::Mat();
+    }
 
-        for (int coluna = 0; coluna < img1_.cols; coluna++)
-        {
-            // Média ponderada conforme padrão ITU-R BT.709
-            double gray_value = 0.114 * pixel__in[coluna][0] +  // B
-                0.587 * pixel__in[coluna][1] +  // G
-                0.299 * pixel__in[coluna][2];   // R
+    uint32_t counts[4][256] = {};
+    HistogramSink counter(counts);
+    cv::Mat result(img1_.rows, img1_.cols, CV_8UC1);
+    for (int linha = 0; linha < img1_.rows; linha++)
+    {
+        // Grava e conta o mesmo vetor, sem reler a linha da imagem convertida
+        StoreSink store{ result.ptr<uchar>(linha) };
+        PairSink<StoreSink, HistogramSink> both{ store, counter };
+        weighted_apply(img1_.ptr<uchar>(linha), static_cast<size_t>(img1_.cols), weights, both);
+    }
+    counter.flush();
 
-// Clamping para garantir range [0, 255]
-            gray_value = std::max(0.0, std::min(255.0, gray_value));
-            pixel_out[coluna] = static_cast<uchar>(gray_value);
-        }
+    for (int v = 0; v < 256; v++)
+    {
+        histogram[v] = static_cast<int>(counts[0][v] + counts[1][v] + counts[2][v] + counts[3][v]);
     }
     return result;
 }
@@ -84,4 +552,127 @@ cv::Mat GrayScale::get_gray_weighted()
 cv::Mat GrayScale::get_gray()
 {
     return get_gray_arithmetic();
-}
\ No newline at end of file
+}
+
+// ================ Entrada/saída por chamada ================
+
+bool GrayScale::convert(const cv::Mat& input, cv::Mat& output, GrayMethod method, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    // create não realoca se output já for CV_8UC1 deste tamanho
+    output.create(input.rows, input.cols, CV_8UC1);
+
+    // Entrada e saída contínuas: uma única sequência de pixels
+    const bool flat = input.isContinuous() && output.isContinuous();
+    const int span_rows = flat ? 1 : input.rows;
+    const size_t span_pixels = flat ? input.total() : static_cast<size_t>(input.cols);
+    const GrayWeights weights = weights_for(standard);
+
+    for (int linha = 0; linha < span_rows; linha++)
+    {
+        convert_span(input.ptr<uchar>(linha), output.ptr<uchar>(linha), span_pixels, method, weights);
+    }
+    return true;
+}
+
+bool GrayScale::convert_rows(const cv::Mat& input, cv::Mat& output, int row_begin, int row_end,
+                             GrayMethod method, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    if (row_begin < 0 || row_end > input.rows || row_begin > row_end)
+    {
+        std::cerr << "Erro: Intervalo de linhas inválido!" << std::endl;
+        return false;
+    }
+
+    output.create(input.rows, input.cols, CV_8UC1);
+    const GrayWeights weights = weights_for(standard);
+
+    for (int linha = row_begin; linha < row_end; linha++)
+    {
+        convert_span(input.ptr<uchar>(linha), output.ptr<uchar>(linha), static_cast<size_t>(input.cols), method, weights);
+    }
+    return true;
+}
+
+bool GrayScale::threshold_weighted(const cv::Mat& input, cv::Mat& mask, uchar threshold_value, uchar max_value,
+                                   bool inverted, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    mask.create(input.rows, input.cols, CV_8UC1);
+    fused_weighted_pass(input, &mask, threshold_value, max_value, inverted, nullptr, weights_for(standard));
+    return true;
+}
+
+bool GrayScale::threshold_weighted(const cv::Mat& input, cv::Mat& mask, std::vector<int>& histogram,
+                                   uchar threshold_value, uchar max_value, bool inverted, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    uint32_t counts[256] = {};
+    mask.create(input.rows, input.cols, CV_8UC1);
+    fused_weighted_pass(input, &mask, threshold_value, max_value, inverted, counts, weights_for(standard));
+    histogram.assign(counts, counts + 256);
+    return true;
+}
+
+bool GrayScale::histogram_weighted(const cv::Mat& input, std::vector<int>& histogram, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    uint32_t counts[256] = {};
+    fused_weighted_pass(input, nullptr, 0, 0, false, counts, weights_for(standard));
+    histogram.assign(counts, counts + 256);
+    return true;
+}
+
+cv::Mat GrayScale::convert_pooled(const cv::Mat& input, GrayMethod method, GrayStandard standard)
+{
+    if (input.empty() || input.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (CV_8UC3)!" << std::endl;
+        return cv::Mat();
+    }
+
+    cv::Mat output = acquire_buffer(cv::Size(input.cols, input.rows));
+    convert(input, output, method, standard);
+    return output;
+}
+
+cv::Mat GrayScale::acquire_buffer(cv::Size size)
+{
+    return pool_.acquire(size);
+}
+
+void GrayScale::recycle_buffer(cv::Mat& buffer)
+{
+    pool_.recycle(buffer);
+}
+
+void GrayScale::release_buffers()
+{
+    pool_.clear();
+}
@@ -0,0 +1,336 @@
+#include "filt/median_filter.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Operações min/max por tipo de vetor; a mesma rede de ordenação serve
+     * ao escalar e aos vetores SSE2/AVX2 (resultados idênticos).
+     */
+    struct ScalarOps
+    {
+        typedef uchar Vec;
+        static Vec load(const uchar* p) { return *p; }
+        static void store(uchar* p, Vec v) { *p = v; }
+        static Vec min(Vec a, Vec b) { return std::min(a, b); }
+        static Vec max(Vec a, Vec b) { return std::max(a, b); }
+        static constexpr int width = 1;
+    };
+
+#if defined(__SSE2__)
+    struct Sse2Ops
+    {
+        typedef __m128i Vec;
+        static Vec load(const uchar* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(uchar* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static Vec min(Vec a, Vec b) { return _mm_min_epu8(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm_max_epu8(a, b); }
+        static constexpr int width = 16;
+    };
+#endif
+
+#if defined(__AVX2__)
+    struct Avx2Ops
+    {
+        typedef __m256i Vec;
+        static Vec load(const uchar* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(uchar* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static Vec min(Vec a, Vec b) { return _mm256_min_epu8(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm256_max_epu8(a, b); }
+        static constexpr int width = 32;
+    };
+#endif
+
+    /**
+     * Ordena o par: a = min(a, b), b = max(a, b).
+     */
+    template <typename Ops>
+    inline void sort_pair(typename Ops::Vec& a, typename Ops::Vec& b)
+    {
+        typename Ops::Vec t = a;
+        a = Ops::min(a, b);
+        b = Ops::max(t, b);
+    }
+
+    /**
+     * Mediana de 9 valores com a rede de 19 comparações (Paeth); o resultado
+     * fica em p[4].
+     */
+    template <typename Ops>
+    inline typename Ops::Vec median9(typename Ops::Vec* p)
+    {
+        sort_pair<Ops>(p[1], p[2]); sort_pair<Ops>(p[4], p[5]); sort_pair<Ops>(p[7], p[8]);
+        sort_pair<Ops>(p[0], p[1]); sort_pair<Ops>(p[3], p[4]); sort_pair<Ops>(p[6], p[7]);
+        sort_pair<Ops>(p[1], p[2]); sort_pair<Ops>(p[4], p[5]); sort_pair<Ops>(p[7], p[8]);
+        sort_pair<Ops>(p[0], p[3]); sort_pair<Ops>(p[5], p[8]); sort_pair<Ops>(p[4], p[7]);
+        sort_pair<Ops>(p[3], p[6]); sort_pair<Ops>(p[1], p[4]); sort_pair<Ops>(p[2], p[5]);
+        sort_pair<Ops>(p[4], p[7]); sort_pair<Ops>(p[4], p[2]); sort_pair<Ops>(p[6], p[4]);
+        sort_pair<Ops>(p[4], p[2]);
+        return p[4];
+    }
+
+    /**
+     * Mediana 3x3 dos bytes [begin, end) de uma linha: os vizinhos
+     * horizontais estão a +-step bytes (step = canais) e precisam existir.
+     * @return Primeiro byte não processado (múltiplo do vetor a partir de begin)
+     */
+    template <typename Ops>
+    int median9_span(const uchar* above, const uchar* center, const uchar* below, uchar* out,
+                     int begin, int end, int step)
+    {
+        int i = begin;
+        for (; i + Ops::width <= end; i += Ops::width)
+        {
+            typename Ops::Vec p[9] = {
+                Ops::load(above + i - step), Ops::load(above + i), Ops::load(above + i + step),
+                Ops::load(center + i - step), Ops::load(center + i), Ops::load(center + i + step),
+                Ops::load(below + i - step), Ops::load(below + i), Ops::load(below + i + step)
+            };
+            Ops::store(out + i, median9<Ops>(p));
+        }
+        return i;
+    }
+
+    /**
+     * Mediana 3x3 de um byte com colunas limitadas às bordas.
+     */
+    inline uchar median9_clamped(const uchar* above, const uchar* center, const uchar* below,
+                                 int i, int step, int row_bytes)
+    {
+        const int left = (i - step >= 0) ? i - step : i;
+        const int right = (i + step < row_bytes) ? i + step : i;
+        uchar p[9] = {
+            above[left], above[i], above[right],
+            center[left], center[i], center[right],
+            below[left], below[i], below[right]
+        };
+        return median9<ScalarOps>(p);
+    }
+
+    /**
+     * Soma (sign = +1) ou subtrai (sign = -1) um histograma de 16 bins
+     * (laço de tamanho fixo, vetorizado pelo compilador).
+     */
+    inline void add_histogram16(uint16_t* dst, const uint16_t* src, int sign)
+    {
+        if (sign > 0)
+        {
+            for (int b = 0; b < 16; b++) dst[b] = static_cast<uint16_t>(dst[b] + src[b]);
+        }
+        else
+        {
+            for (int b = 0; b < 16; b++) dst[b] = static_cast<uint16_t>(dst[b] - src[b]);
+        }
+    }
+}
+
+MedianFilter::MedianFilter()
+{
+}
+
+MedianFilter::~MedianFilter()
+{
+}
+
+cv::Mat MedianFilter::median_filter(const cv::Mat& img, int radius, bool multithreaded)
+{
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (radius < 1 || radius > MAX_RADIUS)
+    {
+        std::cerr << "Erro: Raio deve estar entre 1 e " << MAX_RADIUS << "!" << std::endl;
+        return cv::Mat();
+    }
+
+    cv::Mat result(img.rows, img.cols, img.type());
+
+    // Cada faixa reinicia os histogramas de coluna (custo O(raio) por coluna),
+    // então não vale a pena usar faixas muito mais finas que a janela.
+    const int min_rows = (radius == 1) ? 16 : 2 * radius + 1;
+    const int num_strips = multithreaded ? std::max(1, std::min(cv::getNumThreads(), img.rows / min_rows)) : 1;
+
+    cv::parallel_for_(cv::Range(0, num_strips), [&](const cv::Range& faixa)
+    {
+        for (int s = faixa.start; s < faixa.end; s++)
+        {
+            const int row_begin = static_cast<int>(static_cast<long long>(img.rows) * s / num_strips);
+            const int row_end = static_cast<int>(static_cast<long long>(img.rows) * (s + 1) / num_strips);
+            if (radius == 1)
+            {
+                median_3x3(img, result, row_begin, row_end);
+            }
+            else
+            {
+                median_histogram(img, result, radius, row_begin, row_end);
+            }
+        }
+    }, num_strips);
+
+    return result;
+}
+
+void MedianFilter::median_3x3(const cv::Mat& img, cv::Mat& result, int row_begin, int row_end)
+{
+    const int step = img.channels();
+    const int row_bytes = img.cols * step;
+
+    for (int linha = row_begin; linha < row_end; linha++)
+    {
+        const uchar* above = img.ptr<uchar>(std::max(linha - 1, 0));
+        const uchar* center = img.ptr<uchar>(linha);
+        const uchar* below = img.ptr<uchar>(std::min(linha + 1, img.rows - 1));
+        uchar* out = result.ptr<uchar>(linha);
+
+        // Primeira e última coluna usam o vizinho replicado; o interior
+        // [step, row_bytes - step) tem os dois vizinhos horizontais.
+        const int interior_end = std::max(row_bytes - step, step);
+        for (int i = 0; i < std::min(step, row_bytes); i++)
+        {
+            out[i] = median9_clamped(above, center, below, i, step, row_bytes);
+        }
+
+        int i = step;
+#if defined(__AVX2__)
+        i = median9_span<Avx2Ops>(above, center, below, out, i, interior_end, step);
+#endif
+#if defined(__SSE2__)
+        i = median9_span<Sse2Ops>(above, center, below, out, i, interior_end, step);
+#endif
+        i = median9_span<ScalarOps>(above, center, below, out, i, interior_end, step);
+
+        for (i = interior_end; i < row_bytes; i++)
+        {
+            out[i] = median9_clamped(above, center, below, i, step, row_bytes);
+        }
+    }
+}
+
+void MedianFilter::median_histogram(const cv::Mat& img, cv::Mat& result, int radius, int row_begin, int row_end)
+{
+    const int cn = img.channels();
+    const int cols = img.cols;
+    const int window = 2 * radius + 1;
+    const int padded_cols = cols + 2 * radius;
+    const int rank = (window * window) / 2;   // Posição da mediana (base 0)
+
+    // Histogramas de coluna (janela vertical de 2r + 1 linhas) para as colunas
+    // com borda replicada: a coluna estendida p lê a coluna clamp(p - r).
+    // Fino: 256 bins (um por intensidade); grosso: 16 bins (intensidade >> 4).
+    std::vector<uint16_t> column_fine(static_cast<size_t>(padded_cols) * 256);
+    std::vector<uint16_t> column_coarse(static_cast<size_t>(padded_cols) * 16);
+    std::vector<int> source_col(padded_cols);
+    for (int p = 0; p < padded_cols; p++)
+    {
+        source_col[p] = std::min(std::max(p - radius, 0), cols - 1) * cn;
+    }
+
+    for (int canal = 0; canal < cn; canal++)
+    {
+        std::fill(column_fine.begin(), column_fine.end(), 0);
+        std::fill(column_coarse.begin(), column_coarse.end(), 0);
+
+        // Janela vertical inicial, centrada em row_begin
+        for (int dy = -radius; dy <= radius; dy++)
+        {
+            const uchar* pixel = img.ptr<uchar>(std::min(std::max(row_begin + dy, 0), img.rows - 1)) + canal;
+            for (int p = 0; p < padded_cols; p++)
+            {
+                const uchar v = pixel[source_col[p]];
+                column_fine[static_cast<size_t>(p) * 256 + v]++;
+                column_coarse[static_cast<size_t>(p) * 16 + (v >> 4)]++;
+            }
+        }
+
+        for (int linha = row_begin; linha < row_end; linha++)
+        {
+            if (linha > row_begin)
+            {
+                // Desliza a janela vertical: sai a linha de cima, entra a de baixo
+                const uchar* removed = img.ptr<uchar>(std::max(linha - radius - 1, 0)) + canal;
+                const uchar* added = img.ptr<uchar>(std::min(linha + radius, img.rows - 1)) + canal;
+                for (int p = 0; p < padded_cols; p++)
+                {
+                    const uchar out_v = removed[source_col[p]];
+                    const uchar in_v = added[source_col[p]];
+                    column_fine[static_cast<size_t>(p) * 256 + out_v]--;
+                    column_coarse[static_cast<size_t>(p) * 16 + (out_v >> 4)]--;
+                    column_fine[static_cast<size_t>(p) * 256 + in_v]++;
+                    column_coarse[static_cast<size_t>(p) * 16 + (in_v >> 4)]++;
+                }
+            }
+
+            // Histograma da janela: o grosso é mantido a cada pixel; cada faixa
+            // de 16 bins finos só é atualizada quando a busca passa por ela
+            // (fine_x[k] = coluna de saída para a qual a faixa k está válida).
+            uint16_t kernel_coarse[16] = {};
+            uint16_t kernel_fine[256];
+            int fine_x[16];
+            std::fill(fine_x, fine_x + 16, -window);
+
+            for (int p = 0; p < window; p++)
+            {
+                add_histogram16(kernel_coarse, &column_coarse[static_cast<size_t>(p) * 16], +1);
+            }
+
+            uchar* out = result.ptr<uchar>(linha) + canal;
+            for (int coluna = 0; coluna < cols; coluna++)
+            {
+                if (coluna > 0)
+                {
+                    add_histogram16(kernel_coarse, &column_coarse[static_cast<size_t>(coluna - 1) * 16], -1);
+                    add_histogram16(kernel_coarse, &column_coarse[static_cast<size_t>(coluna + window - 1) * 16], +1);
+                }
+
+                // Busca no histograma grosso
+                int k = 0;
+                int sum = 0;
+                while (sum + kernel_coarse[k] <= rank)
+                {
+                    sum += kernel_coarse[k];
+                    k++;
+                }
+
+                // Atualiza a faixa fina k até a coluna atual
+                uint16_t* fine = kernel_fine + k * 16;
+                if (coluna - fine_x[k] >= window)
+                {
+                    std::memset(fine, 0, 16 * sizeof(uint16_t));
+                    for (int p = coluna; p < coluna + window; p++)
+                    {
+                        add_histogram16(fine, &column_fine[static_cast<size_t>(p) * 256 + k * 16], +1);
+                    }
+                }
+                else
+                {
+                    for (int p = fine_x[k]; p < coluna; p++)
+                    {
+                        add_histogram16(fine, &column_fine[static_cast<size_t>(p) * 256 + k * 16], -1);
+                        add_histogram16(fine, &column_fine[static_cast<size_t>(p + window) * 256 + k * 16], +1);
+                    }
+                }
+                fine_x[k] = coluna;
+
+                // Busca no histograma fino
+                int b = 0;
+                while (sum + fine[b] <= rank)
+                {
+                    sum += fine[b];
+                    b++;
+                }
+                out[static_cast<size_t>(coluna) * cn] = static_cast<uchar>(k * 16 + b);
+            }
+        }
+    }
+}
@@ -1,8 +1,471 @@
 #include "histo/histogram.hpp"
+#include "conv/grayscale.hpp"
+#include "lut/point_lut.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <numeric>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Acumula o histograma das linhas [row_begin, row_end) de uma imagem
+     * CV_8UC1 em hist (somando ao conteúdo existente).
+     * Usa 4 sub-histogramas: pixels consecutivos incrementam tabelas
+     * diferentes, então valores repetidos não serializam em uma mesma posição.
+     */
+    void accumulate_gray_rows(const cv::Mat& img, int row_begin, int row_end, uint32_t* hist)
+    {
+        uint32_t sub[4][256] = {};
+
+        for (int linha = row_begin; linha < row_end; linha++)
+        {
+            const uchar* pixel = img.ptr<uchar>(linha);
+            int coluna = 0;
+            for (; coluna + 4 <= img.cols; coluna += 4)
+            {
+                sub[0][pixel[coluna]]++;
+                sub[1][pixel[coluna + 1]]++;
+                sub[2][pixel[coluna + 2]]++;
+                sub[3][pixel[coluna + 3]]++;
+            }
+            for (; coluna < img.cols; coluna++)
+            {
+                sub[0][pixel[coluna]]++;
+            }
+        }
+
+        for (int i = 0; i < 256; i++)
+        {
+            hist[i] += sub[0][i] + sub[1][i] + sub[2][i] + sub[3][i];
+        }
+    }
+
+    /**
+     * Soma os sub-histogramas BGR (pares e ímpares) aos contadores de 64 bits
+     * e zera os sub-histogramas.
+     */
+    void flush_bgr(uint32_t (&sub)[6][256], HistogramProcessor::ColorHistogramCounts& counts)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            counts.blue[i] += static_cast<uint64_t>(sub[0][i]) + sub[3][i];
+            counts.green[i] += static_cast<uint64_t>(sub[1][i]) + sub[4][i];
+            counts.red[i] += static_cast<uint64_t>(sub[2][i]) + sub[5][i];
+        }
+        std::fill(&sub[0][0], &sub[0][0] + 6 * 256, 0u);
+    }
+
+    /**
+     * Acumula o histograma BGR de uma imagem CV_8UC3 em uma única passada.
+     * Imagens contínuas são percorridas como uma sequência única de pixels.
+     */
+    void accumulate_bgr(const cv::Mat& img, HistogramProcessor::ColorHistogramCounts& counts)
+    {
+        // Cada sub-histograma recebe no máximo metade dos pixels pendentes:
+        // descarregando a cada 2^31 pixels, nenhum contador de 32 bits estoura.
+        const size_t flush_pixels = static_cast<size_t>(1) << 31;
+
+        uint32_t sub[6][256] = {};
+        size_t pending = 0;
+
+        const int span_rows = img.isContinuous() ? 1 : img.rows;
+        const size_t span_pixels = img.isContinuous() ? img.total() : static_cast<size_t>(img.cols);
+
+        for (int linha = 0; linha < span_rows; linha++)
+        {
+            const uchar* pixel = img.ptr<uchar>(linha);
+            size_t restante = span_pixels;
+
+            while (restante > 0)
+            {
+                size_t bloco = std::min(restante, flush_pixels - pending);
+                const uchar* fim = pixel + 3 * (bloco & ~static_cast<size_t>(1));
+
+                // Dois pixels por iteração: pares em sub[0..2], ímpares em sub[3..5]
+                for (; pixel < fim; pixel += 6)
+                {
+                    sub[0][pixel[0]]++;
+                    sub[1][pixel[1]]++;
+                    sub[2][pixel[2]]++;
+                    sub[3][pixel[3]]++;
+                    sub[4][pixel[4]]++;
+                    sub[5][pixel[5]]++;
+                }
+                if (bloco & 1)
+                {
+                    sub[0][pixel[0]]++;
+                    sub[1][pixel[1]]++;
+                    sub[2][pixel[2]]++;
+                    pixel += 3;
+                }
+
+                restante -= bloco;
+                pending += bloco;
+                if (pending == flush_pixels)
+                {
+                    flush_bgr(sub, counts);
+                    pending = 0;
+                }
+            }
+        }
+
+        flush_bgr(sub, counts);
+    }
+
+    /**
+     * Amostra uma imagem de cn canais em grade: linhas 0, stride, 2*stride...
+     * e, em cada linha, colunas phase, phase + stride, ... com phase
+     * pseudoaleatório (hash da linha). counts tem 256 * cn posições.
+     * @return Número de pixels amostrados
+     */
+    uint64_t sample_histogram(const cv::Mat& img, int stride, uint32_t* counts)
+    {
+        const int cn = img.channels();
+        uint64_t sampled = 0;
+        for (int linha = 0; linha < img.rows; linha += stride)
+        {
+            const uint32_t hash = static_cast<uint32_t>(linha) * 2654435761u;
+            const int phase = static_cast<int>((hash >> 16) % static_cast<uint32_t>(std::min(stride, img.cols)));
+            const uchar* pixel = img.ptr<uchar>(linha);
+            for (int coluna = phase; coluna < img.cols; coluna += stride)
+            {
+                const uchar* p = pixel + static_cast<size_t>(coluna) * cn;
+                for (int canal = 0; canal < cn; canal++)
+                {
+                    counts[canal * 256 + p[canal]]++;
+                }
+                sampled++;
+            }
+        }
+        return sampled;
+    }
+
+    /**
+     * Escala as contagens amostradas para o total de pixels.
+     */
+    std::vector<int> scale_counts(const uint32_t* counts, uint64_t sampled, uint64_t total)
+    {
+        std::vector<int> histogram(256);
+        const double scale = static_cast<double>(total) / static_cast<double>(sampled);
+        for (int i = 0; i < 256; i++)
+        {
+            histogram[i] = static_cast<int>(std::lround(counts[i] * scale));
+        }
+        return histogram;
+    }
+
+    /**
+     * Limite DKW com 95% de confiança: sqrt(ln(2 / 0.05) / (2n)).
+     */
+    double sampling_error_bound(uint64_t sampled, uint64_t total)
+    {
+        if (sampled >= total)
+        {
+            return 0.0;
+        }
+        return std::sqrt(std::log(2.0 / 0.05) / (2.0 * static_cast<double>(sampled)));
+    }
+
+    /**
+     * Tabela de equalização global a partir de um histograma (256 bins):
+     * o primeiro nível presente vai para 0 e a distribuição acumulada dos
+     * demais é escalada para [0, 255].
+     */
+    template <typename Count>
+    PointLut::Table equalization_table(const Count* hist)
+    {
+        PointLut::Table table;
+        uint64_t total = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            total += hist[i];
+        }
+
+        int first = 0;
+        while (first < 255 && hist[first] == 0)
+        {
+            first++;
+        }
+
+        // Imagem constante (ou vazia): mantém o único nível presente
+        if (static_cast<uint64_t>(hist[first]) == total)
+        {
+            table.fill(static_cast<uchar>(first));
+            return table;
+        }
+
+        const double scale = 255.0 / static_cast<double>(total - hist[first]);
+        uint64_t sum = 0;
+        for (int i = 0; i <= first; i++)
+        {
+            table[i] = 0;
+        }
+        for (int i = first + 1; i < 256; i++)
+        {
+            sum += hist[i];
+            table[i] = cv::saturate_cast<uchar>(static_cast<double>(sum) * scale);
+        }
+        return table;
+    }
+
+    /**
+     * CDF normalizada de um histograma de 256 bins.
+     * @return false se o histograma estiver vazio (soma zero)
+     */
+    template <typename Count>
+    bool normalized_cdf(const Count* hist, std::array<double, 256>& cdf)
+    {
+        uint64_t sum = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            sum += hist[i];
+            cdf[i] = static_cast<double>(sum);
+        }
+        if (sum == 0)
+        {
+            return false;
+        }
+        for (int i = 0; i < 256; i++)
+        {
+            cdf[i] /= static_cast<double>(sum);
+        }
+        return true;
+    }
+
+    /**
+     * Tabela de especificação em O(256): como as duas CDFs são crescentes,
+     * o nível de referência só avança enquanto percorre os níveis de origem.
+     */
+    PointLut::Table matching_table(const std::array<double, 256>& source, const std::array<double, 256>& reference)
+    {
+        PointLut::Table table;
+        int j = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            while (j < 255 && reference[j] < source[i])
+            {
+                j++;
+            }
+            table[i] = static_cast<uchar>(j);
+        }
+        return table;
+    }
+
+    /**
+     * Acumula min/max/soma/soma dos quadrados de uma sequência de bytes
+     * intercalados com cn canais (o primeiro byte é do canal 0).
+     */
+    template <int cn>
+    void accumulate_channel_stats(const uchar* pixel, size_t bytes, HistogramProcessor::ChannelStats& stats)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        // Grupos de cn blocos de 16 bytes (16 pixels): no bloco c, o byte j
+        // pertence ao canal (16 * c + j) % cn em todos os grupos. Os
+        // acumuladores guardam a posição dos bytes e são reduzidos por canal
+        // a cada 256 grupos (somas de 16 bits e quadrados de 32 bits sem estouro).
+        const size_t group_bytes = 16 * cn;
+        if (bytes >= group_bytes)
+        {
+            __m128i min_acc[cn], max_acc[cn];
+            __m256i sum16[cn], sq32_lo[cn], sq32_hi[cn];
+            for (int c = 0; c < cn; c++)
+            {
+                min_acc[c] = _mm_set1_epi8(static_cast<char>(0xFF));
+                max_acc[c] = _mm_setzero_si128();
+            }
+
+            while (i + group_bytes <= bytes)
+            {
+                for (int c = 0; c < cn; c++)
+                {
+                    sum16[c] = _mm256_setzero_si256();
+                    sq32_lo[c] = _mm256_setzero_si256();
+                    sq32_hi[c] = _mm256_setzero_si256();
+                }
+
+                for (int g = 0; g < 256 && i + group_bytes <= bytes; g++, i += group_bytes)
+                {
+                    for (int c = 0; c < cn; c++)
+                    {
+                        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixel + i + 16 * c));
+                        min_acc[c] = _mm_min_epu8(min_acc[c], v);
+                        max_acc[c] = _mm_max_epu8(max_acc[c], v);
+
+                        __m256i w = _mm256_cvtepu8_epi16(v);
+                        sum16[c] = _mm256_add_epi16(sum16[c], w);
+                        __m256i sq = _mm256_mullo_epi16(w, w);  // <= 65025, cabe em 16 bits sem sinal
+                        sq32_lo[c] = _mm256_add_epi32(sq32_lo[c], _mm256_cvtepu16_epi32(_mm256_castsi256_si128(sq)));
+                        sq32_hi[c] = _mm256_add_epi32(sq32_hi[c], _mm256_cvtepu16_epi32(_mm256_extracti128_si256(sq, 1)));
+                    }
+                }
+
+                for (int c = 0; c < cn; c++)
+                {
+                    uint16_t sums[16];
+                    uint32_t squares[16];
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum16[c]);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(squares), sq32_lo[c]);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(squares + 8), sq32_hi[c]);
+                    for (int j = 0; j < 16; j++)
+                    {
+                        const int canal = (16 * c + j) % cn;
+                        stats.sum[canal] += sums[j];
+                        stats.sum_squares[canal] += squares[j];
+                    }
+                }
+            }
+
+            for (int c = 0; c < cn; c++)
+            {
+                uchar mins[16], maxs[16];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), min_acc[c]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), max_acc[c]);
+                for (int j = 0; j < 16; j++)
+                {
+                    const int canal = (16 * c + j) % cn;
+                    stats.min[canal] = std::min(stats.min[canal], static_cast<int>(mins[j]));
+                    stats.max[canal] = std::max(stats.max[canal], static_cast<int>(maxs[j]));
+                }
+            }
+        }
+#endif
+        // Restante (i é múltiplo de cn: o byte i é do canal 0)
+        for (; i < bytes; i += cn)
+        {
+            for (int canal = 0; canal < cn; canal++)
+            {
+                const int v = pixel[i + canal];
+                stats.min[canal] = std::min(stats.min[canal], v);
+                stats.max[canal] = std::max(stats.max[canal], v);
+                stats.sum[canal] += v;
+                stats.sum_squares[canal] += static_cast<uint64_t>(v * v);
+            }
+        }
+    }
+
+    /**
+     * Tabela CLAHE de um bloco: corta o histograma em clip, redistribui o
+     * excesso uniformemente e escala a distribuição acumulada para [0, 255].
+     * A tabela é guardada em int32 para a leitura por gather na remapeação.
+     */
+    void clahe_tile_lut(uint32_t* hist, int area, int clip, int32_t* lut)
+    {
+        if (clip > 0)
+        {
+            int clipped = 0;
+            for (int i = 0; i < 256; i++)
+            {
+                if (static_cast<int>(hist[i]) > clip)
+                {
+                    clipped += hist[i] - clip;
+                    hist[i] = clip;
+                }
+            }
+
+            const int batch = clipped / 256;
+            int residual = clipped - batch * 256;
+            for (int i = 0; i < 256; i++)
+            {
+                hist[i] += batch;
+            }
+            if (residual > 0)
+            {
+                const int step = std::max(256 / residual, 1);
+                for (int i = 0; i < 256 && residual > 0; i += step, residual--)
+                {
+                    hist[i]++;
+                }
+            }
+        }
+
+        const double scale = 255.0 / area;
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            sum += hist[i];
+            lut[i] = cv::saturate_cast<uchar>(sum * scale);
+        }
+    }
+
+    /**
+     * Interpolação bilinear de uma linha entre as tabelas de duas linhas de
+     * blocos (top e bottom), em ponto fixo Q8 por eixo:
+     *   out = (((lut_tl*(256-wx) + lut_tr*wx) * (256-wy)
+     *          + (lut_bl*(256-wx) + lut_br*wx) * wy) + 2^15) >> 16
+     * offset_left/offset_right são os índices (bloco * 256) dos blocos vizinhos
+     * de cada coluna e weight_x o peso do bloco da direita.
+     */
+    void clahe_remap_row(const uchar* pixel_in, uchar* pixel_out, int cols,
+                         const int32_t* lut_top, const int32_t* lut_bottom, int weight_y,
+                         const int32_t* offset_left, const int32_t* offset_right, const int32_t* weight_x)
+    {
+        int coluna = 0;
+#if defined(__AVX2__)
+        const __m256i wy = _mm256_set1_epi32(weight_y);
+        const __m256i wy_inv = _mm256_set1_epi32(256 - weight_y);
+        const __m256i full = _mm256_set1_epi32(256);
+        const __m256i half = _mm256_set1_epi32(1 << 15);
+        for (; coluna + 8 <= cols; coluna += 8)
+        {
+            __m256i value = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixel_in + coluna)));
+            __m256i idx_l = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(offset_left + coluna)), value);
+            __m256i idx_r = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(offset_right + coluna)), value);
+            __m256i wx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weight_x + coluna));
+            __m256i wx_inv = _mm256_sub_epi32(full, wx);
+
+            __m256i top = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_i32gather_epi32(lut_top, idx_l, 4), wx_inv),
+                _mm256_mullo_epi32(_mm256_i32gather_epi32(lut_top, idx_r, 4), wx));
+            __m256i bottom = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_i32gather_epi32(lut_bottom, idx_l, 4), wx_inv),
+                _mm256_mullo_epi32(_mm256_i32gather_epi32(lut_bottom, idx_r, 4), wx));
+            __m256i blend = _mm256_add_epi32(_mm256_mullo_epi32(top, wy_inv), _mm256_mullo_epi32(bottom, wy));
+            blend = _mm256_srli_epi32(_mm256_add_epi32(blend, half), 16);
+
+            // 8 inteiros de 32 bits (<= 255) -> 8 bytes
+            __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(blend), _mm256_extracti128_si256(blend, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pixel_out + coluna), _mm_packus_epi16(packed, packed));
+        }
+#endif
+        for (; coluna < cols; coluna++)
+        {
+            const int value = pixel_in[coluna];
+            const int wx = weight_x[coluna];
+            const int top = lut_top[offset_left[coluna] + value] * (256 - wx) + lut_top[offset_right[coluna] + value] * wx;
+            const int bottom = lut_bottom[offset_left[coluna] + value] * (256 - wx) + lut_bottom[offset_right[coluna] + value] * wx;
+            pixel_out[coluna] = static_cast<uchar>((top * (256 - weight_y) + bottom * weight_y + (1 << 15)) >> 16);
+        }
+    }
+
+    /**
+     * Vizinhos e peso Q8 de uma coordenada na grade de blocos: a posição é
+     * medida em relação aos centros dos blocos e limitada às bordas.
+     */
+    void clahe_neighbors(int coord, int tile_size, int num_tiles, int& first, int& second, int& weight)
+    {
+        const double position = (coord + 0.5) / tile_size - 0.5;
+        const int base = static_cast<int>(std::floor(position));
+        weight = static_cast<int>(std::lround((position - base) * 256.0));
+        first = std::max(base, 0);
+        second = std::min(base + 1, num_tiles - 1);
+        if (weight == 256)
+        {
+            // Arredondamento encostou no próximo bloco
+            first = second;
+            weight = 0;
+        }
+    }
+}
+
 HistogramProcessor::HistogramProcessor()
 {
 }
@@ -42,9 +505,80 @@ std::vector<int> HistogramProcessor::compute_histogram_gray(const cv::Mat& img)
     return histogram;
 }
 
-HistogramProcessor::ColorHistogram HistogramProcessor::compute_histogram_color(const cv::Mat& img)
+std::vector<int> HistogramProcessor::compute_histogram_gray_parallel(const cv::Mat& img)
+{
+    if (!is_valid_image(img, 1))
+    {
+        std::cerr << "Erro: Imagem deve ser em tons de cinza (1 canal)!" << std::endl;
+        return std::vector<int>();
+    }
+
+    uint32_t total[256] = {};
+    std::mutex merge_mutex;
+
+    // Uma faixa por thread; cada faixa acumula em histogramas privados e
+    // só a soma final (256 bins) é feita sob exclusão mútua.
+    cv::parallel_for_(cv::Range(0, img.rows), [&](const cv::Range& faixa)
+    {
+        uint32_t local[256] = {};
+        accumulate_gray_rows(img, faixa.start, faixa.end, local);
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        for (int i = 0; i < 256; i++)
+        {
+            total[i] += local[i];
+        }
+    }, cv::getNumThreads());
+
+    return std::vector<int>(total, total + 256);
+}
+
+std::vector<int> HistogramProcessor::compute_histogram_luma(const cv::Mat& img)
+{
+    if (!is_valid_image(img, 3))
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (3 canais)!" << std::endl;
+        return std::vector<int>();
+    }
+
+    GrayScale converter;
+    std::vector<int> histogram;
+    converter.histogram_weighted(img, histogram);
+    return histogram;
+}
+
+std::vector<int> HistogramProcessor::compute_histogram_gray_approx(const cv::Mat& img, int stride, double& error_bound)
+{
+    error_bound = 1.0;
+
+    if (!is_valid_image(img, 1))
+    {
+        std::cerr << "Erro: Imagem deve ser em tons de cinza (1 canal)!" << std::endl;
+        return std::vector<int>();
+    }
+
+    if (stride < 1)
+    {
+        std::cerr << "Erro: Passo de amostragem deve ser >= 1!" << std::endl;
+        return std::vector<int>();
+    }
+
+    if (stride == 1)
+    {
+        error_bound = 0.0;
+        return compute_histogram_gray_parallel(img);
+    }
+
+    uint32_t counts[256] = {};
+    const uint64_t sampled = sample_histogram(img, stride, counts);
+    error_bound = sampling_error_bound(sampled, img.total());
+    return scale_counts(counts, sampled, img.total());
+}
+
+HistogramProcessor::ColorHistogram HistogramProcessor::compute_histogram_color_approx(const cv::Mat& img, int stride, double& error_bound)
 {
     ColorHistogram result;
+    error_bound = 1.0;
 
     if (!is_valid_image(img, 3))
     {
@@ -52,24 +586,60 @@ HistogramProcessor::ColorHistogram HistogramProcessor::compute_histogram_color(c
         return result;
     }
 
-    result.blue_hist = std::vector<int>(256, 0);
-    result.green_hist = std::vector<int>(256, 0);
-    result.red_hist = std::vector<int>(256, 0);
+    if (stride < 1)
+    {
+        std::cerr << "Erro: Passo de amostragem deve ser >= 1!" << std::endl;
+        return result;
+    }
 
-    for (int linha = 0; linha < img.rows; linha++)
+    if (stride == 1)
     {
-        const cv::Vec3b* pixel = img.ptr<cv::Vec3b>(linha);
-        for (int coluna = 0; coluna < img.cols; coluna++)
-        {
-            result.blue_hist[pixel[coluna][0]]++;   // Canal B
-            result.green_hist[pixel[coluna][1]]++;  // Canal G
-            result.red_hist[pixel[coluna][2]]++;    // Canal R
-        }
+        error_bound = 0.0;
+        return compute_histogram_color(img);
     }
 
+    uint32_t counts[3 * 256] = {};
+    const uint64_t sampled = sample_histogram(img, stride, counts);
+    error_bound = sampling_error_bound(sampled, img.total());
+    result.blue_hist = scale_counts(counts, sampled, img.total());
+    result.green_hist = scale_counts(counts + 256, sampled, img.total());
+    result.red_hist = scale_counts(counts + 512, sampled, img.total());
     return result;
 }
 
+HistogramProcessor::ColorHistogram HistogramProcessor::compute_histogram_color(const cv::Mat& img)
+{
+    ColorHistogram result;
+
+    ColorHistogramCounts counts;
+    if (!compute_histogram_color_counts(img, counts))
+    {
+        return result;
+    }
+
+    result.blue_hist.assign(counts.blue.begin(), counts.blue.end());
+    result.green_hist.assign(counts.green.begin(), counts.green.end());
+    result.red_hist.assign(counts.red.begin(), counts.red.end());
+
+    return result;
+}
+
+bool HistogramProcessor::compute_histogram_color_counts(const cv::Mat& img, ColorHistogramCounts& counts)
+{
+    counts.blue.fill(0);
+    counts.green.fill(0);
+    counts.red.fill(0);
+
+    if (!is_valid_image(img, 3))
+    {
+        std::cerr << "Erro: Imagem deve ser colorida (3 canais)!" << std::endl;
+        return false;
+    }
+
+    accumulate_bgr(img, counts);
+    return true;
+}
+
 std::vector<int> HistogramProcessor::compute_histogram_channel(const cv::Mat& img, int channel)
 {
     if (!is_valid_image(img, 3))
@@ -84,18 +654,200 @@ std::vector<int> HistogramProcessor::compute_histogram_channel(const cv::Mat& im
         return std::vector<int>();
     }
 
-    std::vector<int> histogram(256, 0);
+    ColorHistogramCounts counts;
+    compute_histogram_color_counts(img, counts);
 
-    for (int linha = 0; linha < img.rows; linha++)
+    const HistogramCounts& selected = (channel == 0) ? counts.blue : (channel == 1) ? counts.green : counts.red;
+    return std::vector<int>(selected.begin(), selected.end());
+}
+
+// ================ Equalização ================
+
+cv::Mat HistogramProcessor::equalize_histogram(const cv::Mat& img)
+{
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
     {
-        const cv::Vec3b* pixel = img.ptr<cv::Vec3b>(linha);
-        for (int coluna = 0; coluna < img.cols; coluna++)
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (img.channels() == 1)
+    {
+        std::vector<int> histogram = compute_histogram_gray_parallel(img);
+        return PointLut(equalization_table(histogram.data())).apply(img);
+    }
+
+    ColorHistogramCounts counts;
+    compute_histogram_color_counts(img, counts);
+    PointLut lut(equalization_table(counts.blue.data()),
+                 equalization_table(counts.green.data()),
+                 equalization_table(counts.red.data()));
+    return lut.apply(img);
+}
+
+cv::Mat HistogramProcessor::equalize_clahe(const cv::Mat& img, double clip_limit, cv::Size tile_grid)
+{
+    if (!is_valid_image(img, 1))
+    {
+        std::cerr << "Erro: Imagem deve ser em tons de cinza (1 canal)!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (tile_grid.width <= 0 || tile_grid.height <= 0)
+    {
+        std::cerr << "Erro: Grade de blocos deve ser positiva!" << std::endl;
+        return cv::Mat();
+    }
+
+    // Blocos de tamanho ceil(dimensão / grade); a última linha/coluna de
+    // blocos pode ser menor e a grade é reduzida se sobrarem blocos vazios.
+    const int tile_w = (img.cols + std::min(tile_grid.width, img.cols) - 1) / std::min(tile_grid.width, img.cols);
+    const int tile_h = (img.rows + std::min(tile_grid.height, img.rows) - 1) / std::min(tile_grid.height, img.rows);
+    const int tiles_x = (img.cols + tile_w - 1) / tile_w;
+    const int tiles_y = (img.rows + tile_h - 1) / tile_h;
+
+    // 1) Tabela de cada bloco, em paralelo
+    std::vector<int32_t> luts(static_cast<size_t>(tiles_x) * tiles_y * 256);
+    cv::parallel_for_(cv::Range(0, tiles_x * tiles_y), [&](const cv::Range& faixa)
+    {
+        for (int tile = faixa.start; tile < faixa.end; tile++)
         {
-            histogram[pixel[coluna][channel]]++;
+            const int x0 = (tile % tiles_x) * tile_w;
+            const int y0 = (tile / tiles_x) * tile_h;
+            const int x1 = std::min(x0 + tile_w, img.cols);
+            const int y1 = std::min(y0 + tile_h, img.rows);
+            const int area = (x1 - x0) * (y1 - y0);
+
+            uint32_t hist[256] = {};
+            for (int linha = y0; linha < y1; linha++)
+            {
+                const uchar* pixel = img.ptr<uchar>(linha);
+                for (int coluna = x0; coluna < x1; coluna++)
+                {
+                    hist[pixel[coluna]]++;
+                }
+            }
+
+            const int clip = (clip_limit > 0.0) ? std::max(static_cast<int>(clip_limit * area / 256), 1) : 0;
+            clahe_tile_lut(hist, area, clip, &luts[static_cast<size_t>(tile) * 256]);
         }
+    });
+
+    // 2) Vizinhos e pesos por coluna (comuns a todas as linhas)
+    std::vector<int32_t> offset_left(img.cols), offset_right(img.cols), weight_x(img.cols);
+    for (int coluna = 0; coluna < img.cols; coluna++)
+    {
+        int left, right;
+        clahe_neighbors(coluna, tile_w, tiles_x, left, right, weight_x[coluna]);
+        offset_left[coluna] = left * 256;
+        offset_right[coluna] = right * 256;
     }
 
-    return histogram;
+    // 3) Remapeamento bilinear, em paralelo por linhas
+    cv::Mat result(img.rows, img.cols, CV_8UC1);
+    cv::parallel_for_(cv::Range(0, img.rows), [&](const cv::Range& faixa)
+    {
+        for (int linha = faixa.start; linha < faixa.end; linha++)
+        {
+            int top, bottom, weight_y;
+            clahe_neighbors(linha, tile_h, tiles_y, top, bottom, weight_y);
+            clahe_remap_row(img.ptr<uchar>(linha), result.ptr<uchar>(linha), img.cols,
+                            &luts[static_cast<size_t>(top) * tiles_x * 256],
+                            &luts[static_cast<size_t>(bottom) * tiles_x * 256], weight_y,
+                            offset_left.data(), offset_right.data(), weight_x.data());
+        }
+    });
+
+    return result;
+}
+
+// ================ Especificação de histograma ================
+
+HistogramProcessor::ReferenceCdf HistogramProcessor::build_reference_cdf(const cv::Mat& reference)
+{
+    ReferenceCdf result;
+    result.channels = 0;
+
+    if (reference.empty() || (reference.type() != CV_8UC1 && reference.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Referência deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return result;
+    }
+
+    if (reference.channels() == 1)
+    {
+        std::vector<int> histogram = compute_histogram_gray_parallel(reference);
+        normalized_cdf(histogram.data(), result.cdf[0]);
+        result.channels = 1;
+        return result;
+    }
+
+    ColorHistogramCounts counts;
+    compute_histogram_color_counts(reference, counts);
+    normalized_cdf(counts.blue.data(), result.cdf[0]);
+    normalized_cdf(counts.green.data(), result.cdf[1]);
+    normalized_cdf(counts.red.data(), result.cdf[2]);
+    result.channels = 3;
+    return result;
+}
+
+HistogramProcessor::ReferenceCdf HistogramProcessor::build_reference_cdf(const std::vector<int>& histogram)
+{
+    ReferenceCdf result;
+    result.channels = 0;
+
+    if (histogram.size() != 256 || !normalized_cdf(histogram.data(), result.cdf[0]))
+    {
+        std::cerr << "Erro: Histograma de referência deve ter 256 elementos e soma positiva!" << std::endl;
+        return result;
+    }
+
+    result.channels = 1;
+    return result;
+}
+
+cv::Mat HistogramProcessor::match_histogram(const cv::Mat& img, const ReferenceCdf& reference)
+{
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (reference.channels != img.channels())
+    {
+        std::cerr << "Erro: Referência e imagem devem ter o mesmo número de canais!" << std::endl;
+        return cv::Mat();
+    }
+
+    std::array<double, 256> source;
+    if (img.channels() == 1)
+    {
+        std::vector<int> histogram = compute_histogram_gray_parallel(img);
+        normalized_cdf(histogram.data(), source);
+        return PointLut(matching_table(source, reference.cdf[0])).apply(img);
+    }
+
+    ColorHistogramCounts counts;
+    compute_histogram_color_counts(img, counts);
+    PointLut::Table tables[3];
+    const HistogramCounts* channel_counts[3] = { &counts.blue, &counts.green, &counts.red };
+    for (int canal = 0; canal < 3; canal++)
+    {
+        normalized_cdf(channel_counts[canal]->data(), source);
+        tables[canal] = matching_table(source, reference.cdf[canal]);
+    }
+    return PointLut(tables[0], tables[1], tables[2]).apply(img);
+}
+
+cv::Mat HistogramProcessor::match_histogram(const cv::Mat& img, const cv::Mat& reference)
+{
+    ReferenceCdf reference_cdf = build_reference_cdf(reference);
+    if (reference_cdf.channels == 0)
+    {
+        return cv::Mat();
+    }
+    return match_histogram(img, reference_cdf);
 }
 
 // ================ Visualização de histogramas ================
@@ -119,41 +871,17 @@ cv::Mat HistogramProcessor::visualize_histogram_color(const cv::Mat& img, int hi
         return cv::Mat();
     }
 
-    // Cria imagem para visualização
-    cv::Mat hist_image = cv::Mat::zeros(hist_height, hist_width, CV_8UC3);
-
-    // Encontra o valor máximo entre todos os canais para normalização
-    int max_blue = find_histogram_max(color_hist.blue_hist);
-    int max_green = find_histogram_max(color_hist.green_hist);
-    int max_red = find_histogram_max(color_hist.red_hist);
-    int max_value = std::max({ max_blue, max_green, max_red });
-
-    if (max_value == 0) return hist_image;
-
-    int bin_width = hist_width / 256;
-
-    // Desenha histogramas dos três canais sobrepostos
-    for (int i = 0; i < 256; i++)
+    if (hist_height <= 0 || hist_width <= 0)
     {
-        // Normaliza as alturas
-        int blue_height = static_cast<int>((static_cast<double>(color_hist.blue_hist[i]) / max_value) * hist_height);
-        int green_height = static_cast<int>((static_cast<double>(color_hist.green_hist[i]) / max_value) * hist_height);
-        int red_height = static_cast<int>((static_cast<double>(color_hist.red_hist[i]) / max_value) * hist_height);
-
-        // Desenha linhas verticais para cada canal
-        cv::Point pt1_b(i * bin_width, hist_height);
-        cv::Point pt2_b(i * bin_width, hist_height - blue_height);
-        cv::line(hist_image, pt1_b, pt2_b, cv::Scalar(255, 0, 0), 1); // Azul
-
-        cv::Point pt1_g(i * bin_width, hist_height);
-        cv::Point pt2_g(i * bin_width, hist_height - green_height);
-        cv::line(hist_image, pt1_g, pt2_g, cv::Scalar(0, 255, 0), 1); // Verde
-
-        cv::Point pt1_r(i * bin_width, hist_height);
-        cv::Point pt2_r(i * bin_width, hist_height - red_height);
-        cv::line(hist_image, pt1_r, pt2_r, cv::Scalar(0, 0, 255), 1); // Vermelho
+        std::cerr << "Erro: Dimensões da visualização devem ser positivas!" << std::endl;
+        return cv::Mat();
     }
 
+    // Histogramas dos três canais sobrepostos, na mesma escala
+    cv::Mat hist_image(hist_height, hist_width, CV_8UC3);
+    render_histograms({ &color_hist.blue_hist, &color_hist.green_hist, &color_hist.red_hist },
+                      { cv::Scalar(255, 0, 0), cv::Scalar(0, 255, 0), cv::Scalar(0, 0, 255) }, hist_image);
+
     return hist_image;
 }
 
@@ -165,22 +893,112 @@ cv::Mat HistogramProcessor::visualize_histogram(const std::vector<int>& histogra
         return cv::Mat();
     }
 
-    cv::Mat hist_image = cv::Mat::zeros(hist_height, hist_width, CV_8UC3);
+    if (hist_height <= 0 || hist_width <= 0)
+    {
+        std::cerr << "Erro: Dimensões da visualização devem ser positivas!" << std::endl;
+        return cv::Mat();
+    }
 
-    int max_value = find_histogram_max(histogram);
-    if (max_value == 0) return hist_image;
+    cv::Mat hist_image(hist_height, hist_width, CV_8UC3);
+    render_histograms({ &histogram }, { color }, hist_image);
 
-    int bin_width = hist_width / 256;
+    return hist_image;
+}
 
-    for (int i = 0; i < 256; i++)
+bool HistogramProcessor::render_histograms(const std::vector<const std::vector<int>*>& histograms, const std::vector<cv::Scalar>& colors,
+                                           cv::Mat& canvas, bool log_scale)
+{
+    if (canvas.empty() || canvas.type() != CV_8UC3)
     {
-        int height = static_cast<int>((static_cast<double>(histogram[i]) / max_value) * hist_height);
-        cv::Point pt1(i * bin_width, hist_height);
-        cv::Point pt2(i * bin_width, hist_height - height);
-        cv::line(hist_image, pt1, pt2, color, 1);
+        std::cerr << "Erro: Buffer de desenho deve ser CV_8UC3 já alocado!" << std::endl;
+        return false;
     }
 
-    return hist_image;
+    if (histograms.empty() || histograms.size() != colors.size())
+    {
+        std::cerr << "Erro: Informe uma cor para cada histograma!" << std::endl;
+        return false;
+    }
+
+    for (const std::vector<int>* histogram : histograms)
+    {
+        if (histogram == nullptr || histogram->size() != 256)
+        {
+            std::cerr << "Erro: Histograma deve ter 256 elementos!" << std::endl;
+            return false;
+        }
+    }
+
+    const int height = canvas.rows;
+    const int width = canvas.cols;
+    const size_t count = histograms.size();
+
+    // Área auxiliar por coluna, reutilizada entre quadros (só cresce)
+    if (render_scratch_.size() < count * width)
+    {
+        render_scratch_.resize(count * width);
+    }
+    int* bar_top = render_scratch_.data();
+
+    // Reamostragem: coluna x -> maior valor dos bins [x*256/w, (x+1)*256/w)
+    // (pelo menos um bin, para larguras maiores que 256)
+    int max_value = 0;
+    for (size_t k = 0; k < count; k++)
+    {
+        const int* histogram = histograms[k]->data();
+        for (int coluna = 0; coluna < width; coluna++)
+        {
+            const int first = static_cast<int>(static_cast<long long>(coluna) * 256 / width);
+            const int last = std::max(first + 1, static_cast<int>(static_cast<long long>(coluna + 1) * 256 / width));
+            const int value = *std::max_element(histogram + first, histogram + last);
+            bar_top[k * width + coluna] = value;
+            max_value = std::max(max_value, value);
+        }
+    }
+
+    // Altura das barras (no mesmo espaço): primeira linha preenchida de cada coluna
+    const double scale_max = log_scale ? std::log1p(static_cast<double>(max_value)) : static_cast<double>(max_value);
+    for (size_t i = 0; i < count * width; i++)
+    {
+        if (max_value == 0)
+        {
+            bar_top[i] = height;
+            continue;
+        }
+        const double value = log_scale ? std::log1p(static_cast<double>(bar_top[i])) : static_cast<double>(bar_top[i]);
+        bar_top[i] = height - static_cast<int>(value / scale_max * height);
+    }
+
+    // Escrita linha a linha no buffer (fundo preto, cores somadas com saturação)
+    for (int linha = 0; linha < height; linha++)
+    {
+        uchar* pixel = canvas.ptr<uchar>(linha);
+        std::memset(pixel, 0, static_cast<size_t>(width) * 3);
+
+        for (size_t k = 0; k < count; k++)
+        {
+            const int* top = &bar_top[k * width];
+            const uchar color[3] = { cv::saturate_cast<uchar>(colors[k][0]), cv::saturate_cast<uchar>(colors[k][1]),
+                                     cv::saturate_cast<uchar>(colors[k][2]) };
+            for (int coluna = 0; coluna < width; coluna++)
+            {
+                if (linha >= top[coluna])
+                {
+                    uchar* p = pixel + coluna * 3;
+                    p[0] = static_cast<uchar>(std::min(p[0] + color[0], 255));
+                    p[1] = static_cast<uchar>(std::min(p[1] + color[1], 255));
+                    p[2] = static_cast<uchar>(std::min(p[2] + color[2], 255));
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void HistogramProcessor::release_render_buffer()
+{
+    std::vector<int>().swap(render_scratch_);
 }
 
 // ================ Operações auxiliares ================
@@ -236,3 +1054,182 @@ int HistogramProcessor::find_histogram_max(const std::vector<int>& histogram)
 
     return *std::max_element(histogram.begin(), histogram.end());
 }
+
+// ================ Comparação de histogramas ================
+
+double HistogramProcessor::compare_histograms(const std::vector<int>& hist_a, const std::vector<int>& hist_b, CompareMethod method)
+{
+    if (hist_a.empty() || hist_a.size() != hist_b.size())
+    {
+        std::cerr << "Erro: Histogramas devem ter o mesmo número de bins!" << std::endl;
+        return -1.0;
+    }
+
+    const double total_a = static_cast<double>(std::accumulate(hist_a.begin(), hist_a.end(), 0LL));
+    const double total_b = static_cast<double>(std::accumulate(hist_b.begin(), hist_b.end(), 0LL));
+    if (total_a <= 0.0 || total_b <= 0.0)
+    {
+        std::cerr << "Erro: Histogramas devem ter soma positiva!" << std::endl;
+        return -1.0;
+    }
+
+    double result = 0.0;
+    double cdf_diff = 0.0;
+    for (size_t i = 0; i < hist_a.size(); i++)
+    {
+        const double p = hist_a[i] / total_a;
+        const double q = hist_b[i] / total_b;
+
+        switch (method)
+        {
+            case COMPARE_CHI_SQUARE:
+                if (p + q > 0.0) result += (p - q) * (p - q) / (p + q);
+                break;
+            case COMPARE_INTERSECTION:
+                result += std::min(p, q);
+                break;
+            case COMPARE_BHATTACHARYYA:
+                result += std::sqrt(p * q);
+                break;
+            case COMPARE_EMD:
+                // Em 1-D o EMD é a área entre as distribuições acumuladas
+                cdf_diff += p - q;
+                result += std::fabs(cdf_diff);
+                break;
+            default:
+                std::cerr << "Erro: Métrica de comparação desconhecida!" << std::endl;
+                return -1.0;
+        }
+    }
+
+    if (method == COMPARE_BHATTACHARYYA)
+    {
+        result = std::sqrt(std::max(1.0 - result, 0.0));
+    }
+
+    return result;
+}
+
+// ================ Estatísticas de intensidade ================
+
+HistogramProcessor::IntensityStats HistogramProcessor::compute_intensity_stats(const std::vector<int>& histogram)
+{
+    IntensityStats stats = {};
+
+    if (histogram.size() != 256)
+    {
+        std::cerr << "Erro: Histograma deve ter 256 elementos!" << std::endl;
+        return stats;
+    }
+
+    uint64_t count = 0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (int i = 0; i < 256; i++)
+    {
+        count += histogram[i];
+        sum += static_cast<double>(histogram[i]) * i;
+        sum_squares += static_cast<double>(histogram[i]) * i * i;
+    }
+
+    if (count == 0)
+    {
+        return stats;
+    }
+
+    stats.count = count;
+    stats.min = 0;
+    while (histogram[stats.min] == 0)
+    {
+        stats.min++;
+    }
+    stats.max = 255;
+    while (histogram[stats.max] == 0)
+    {
+        stats.max--;
+    }
+
+    stats.mean = sum / count;
+    stats.variance = std::max(sum_squares / count - stats.mean * stats.mean, 0.0);
+    stats.stddev = std::sqrt(stats.variance);
+    stats.median = compute_percentile(histogram, 50.0);
+
+    for (int i = 0; i < 256; i++)
+    {
+        if (histogram[i] > 0)
+        {
+            const double p = static_cast<double>(histogram[i]) / count;
+            stats.entropy -= p * std::log2(p);
+        }
+    }
+
+    return stats;
+}
+
+int HistogramProcessor::compute_percentile(const std::vector<int>& histogram, double percentile)
+{
+    if (histogram.size() != 256 || percentile < 0.0 || percentile > 100.0)
+    {
+        std::cerr << "Erro: Histograma deve ter 256 elementos e percentil estar em [0, 100]!" << std::endl;
+        return -1;
+    }
+
+    uint64_t count = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        count += histogram[i];
+    }
+    if (count == 0)
+    {
+        return -1;
+    }
+
+    // Menor nível com acumulado >= percentile% (pelo menos 1 pixel)
+    const double target = std::max(percentile / 100.0 * static_cast<double>(count), 1.0);
+    uint64_t accumulated = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        accumulated += histogram[i];
+        if (static_cast<double>(accumulated) >= target)
+        {
+            return i;
+        }
+    }
+    return 255;
+}
+
+bool HistogramProcessor::compute_channel_stats(const cv::Mat& img, ChannelStats& stats)
+{
+    stats.channels = 0;
+    stats.count = 0;
+    stats.min.fill(255);
+    stats.max.fill(0);
+    stats.sum.fill(0);
+    stats.sum_squares.fill(0);
+
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return false;
+    }
+
+    const int cn = img.channels();
+    const int span_rows = img.isContinuous() ? 1 : img.rows;
+    const size_t span_bytes = (img.isContinuous() ? img.total() : static_cast<size_t>(img.cols)) * cn;
+
+    for (int linha = 0; linha < span_rows; linha++)
+    {
+        if (cn == 1)
+        {
+            accumulate_channel_stats<1>(img.ptr<uchar>(linha), span_bytes, stats);
+        }
+        else
+        {
+            accumulate_channel_stats<3>(img.ptr<uchar>(linha), span_bytes, stats);
+        }
+    }
+
+    stats.channels = cn;
+    stats.count = img.total();
+    return true;
+}
@@ -0,0 +1,261 @@
+#include "histo/histogram_index.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    const char INDEX_MAGIC[4] = { 'P', 'D', 'I', 'H' };
+    const uint32_t INDEX_VERSION = 1;
+
+    /**
+     * Distância L1 entre duas assinaturas de 64 bins.
+     * Os bins são <= 32767: |a - b| cabe em int16 e madd com 1 soma pares
+     * em 32 bits sem estouro.
+     */
+    inline uint32_t l1_distance(const uint16_t* a, const uint16_t* b)
+    {
+#if defined(__AVX2__)
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i acc = _mm256_setzero_si256();
+        for (int i = 0; i < HistogramIndex::BINS; i += 16)
+        {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i diff = _mm256_sub_epi16(_mm256_max_epu16(va, vb), _mm256_min_epu16(va, vb));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(diff, ones));
+        }
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+#else
+        uint32_t distance = 0;
+        for (int i = 0; i < HistogramIndex::BINS; i++)
+        {
+            distance += (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+        }
+        return distance;
+#endif
+    }
+
+    /**
+     * Ordem dos resultados: menor distância, depois menor id.
+     */
+    inline bool match_less(const HistogramIndex::Match& x, const HistogramIndex::Match& y)
+    {
+        return (x.distance != y.distance) ? x.distance < y.distance : x.id < y.id;
+    }
+}
+
+HistogramIndex::HistogramIndex()
+{
+}
+
+HistogramIndex::~HistogramIndex()
+{
+}
+
+bool HistogramIndex::compute_signature(const cv::Mat& img, Signature& signature) const
+{
+    signature.fill(0);
+
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return false;
+    }
+
+    // Bin conjunto: (B >> 6) * 16 + (G >> 6) * 4 + (R >> 6)
+    uint64_t counts[BINS] = {};
+    const int cn = img.channels();
+    for (int linha = 0; linha < img.rows; linha++)
+    {
+        const uchar* pixel = img.ptr<uchar>(linha);
+        if (cn == 1)
+        {
+            for (int coluna = 0; coluna < img.cols; coluna++)
+            {
+                const int level = pixel[coluna] >> 6;
+                counts[level * 21]++;   // 21 = 16 + 4 + 1 (mesmo nível nos três canais)
+            }
+        }
+        else
+        {
+            for (int coluna = 0; coluna < img.cols; coluna++, pixel += 3)
+            {
+                counts[((pixel[0] >> 6) << 4) | ((pixel[1] >> 6) << 2) | (pixel[2] >> 6)]++;
+            }
+        }
+    }
+
+    const double scale = static_cast<double>(SIGNATURE_SCALE) / img.total();
+    for (int i = 0; i < BINS; i++)
+    {
+        signature[i] = static_cast<uint16_t>(std::lround(counts[i] * scale));
+    }
+    return true;
+}
+
+int HistogramIndex::add(const cv::Mat& img)
+{
+    Signature signature;
+    if (!compute_signature(img, signature))
+    {
+        return -1;
+    }
+    return add_signature(signature);
+}
+
+int HistogramIndex::add_signature(const Signature& signature)
+{
+    const int id = static_cast<int>(size());
+    signatures_.insert(signatures_.end(), signature.begin(), signature.end());
+    return id;
+}
+
+std::vector<HistogramIndex::Match> HistogramIndex::query(const cv::Mat& img, int k) const
+{
+    Signature signature;
+    if (!compute_signature(img, signature))
+    {
+        return std::vector<Match>();
+    }
+    return query(signature, k);
+}
+
+std::vector<HistogramIndex::Match> HistogramIndex::query(const Signature& signature, int k) const
+{
+    std::vector<Match> best;
+    const int count = static_cast<int>(size());
+    if (k <= 0 || count == 0)
+    {
+        return best;
+    }
+    k = std::min(k, count);
+
+    // Cada faixa mantém um max-heap com seus k melhores; os heaps são
+    // combinados sob exclusão mútua (no máximo k entradas por faixa).
+    std::mutex merge_mutex;
+    cv::parallel_for_(cv::Range(0, count), [&](const cv::Range& faixa)
+    {
+        std::vector<Match> local;
+        local.reserve(k + 1);
+        for (int id = faixa.start; id < faixa.end; id++)
+        {
+            Match candidate = { id, l1_distance(signature.data(), &signatures_[static_cast<size_t>(id) * BINS]) };
+            if (static_cast<int>(local.size()) < k)
+            {
+                local.push_back(candidate);
+                std::push_heap(local.begin(), local.end(), match_less);
+            }
+            else if (match_less(candidate, local.front()))
+            {
+                std::pop_heap(local.begin(), local.end(), match_less);
+                local.back() = candidate;
+                std::push_heap(local.begin(), local.end(), match_less);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        best.insert(best.end(), local.begin(), local.end());
+    }, cv::getNumThreads());
+
+    std::sort(best.begin(), best.end(), match_less);
+    best.resize(k);
+    return best;
+}
+
+size_t HistogramIndex::size() const
+{
+    return signatures_.size() / BINS;
+}
+
+void HistogramIndex::clear()
+{
+    signatures_.clear();
+}
+
+bool HistogramIndex::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Erro: Não foi possível criar " << path << "!" << std::endl;
+        return false;
+    }
+
+    const uint32_t bins = BINS;
+    const uint64_t count = size();
+    file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    file.write(reinterpret_cast<const char*>(&INDEX_VERSION), sizeof(INDEX_VERSION));
+    file.write(reinterpret_cast<const char*>(&bins), sizeof(bins));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(signatures_.data()),
+               static_cast<std::streamsize>(signatures_.size() * sizeof(uint16_t)));
+
+    if (!file)
+    {
+        std::cerr << "Erro: Falha ao gravar " << path << "!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool HistogramIndex::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Erro: Não foi possível abrir " << path << "!" << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t bins = 0;
+    uint64_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&bins), sizeof(bins));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    if (!file || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        version != INDEX_VERSION || bins != static_cast<uint32_t>(BINS))
+    {
+        std::cerr << "Erro: Arquivo de índice inválido: " << path << "!" << std::endl;
+        return false;
+    }
+
+    // A quantidade do cabeçalho deve corresponder exatamente aos bytes
+    // restantes; comparar por divisão evita estouro em count * bytes.
+    const std::streamoff header_end = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff file_end = file.tellg();
+    file.seekg(header_end);
+    const uint64_t signature_bytes = BINS * sizeof(uint16_t);
+    const uint64_t remaining = (header_end >= 0 && file_end >= header_end)
+        ? static_cast<uint64_t>(file_end - header_end) : 0;
+    if (!file || count > remaining / signature_bytes || count * signature_bytes != remaining)
+    {
+        std::cerr << "Erro: Arquivo de índice truncado ou com tamanho inconsistente: " << path << "!" << std::endl;
+        return false;
+    }
+
+    std::vector<uint16_t> loaded(static_cast<size_t>(count) * BINS);
+    file.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(uint16_t)));
+    if (!file)
+    {
+        std::cerr << "Erro: Falha ao ler " << path << "!" << std::endl;
+        return false;
+    }
+
+    signatures_.swap(loaded);
+    return true;
+}
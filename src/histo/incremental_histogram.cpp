@@ -0,0 +1,179 @@
+#include "histo/incremental_histogram.hpp"
+#include <algorithm>
+#include <iostream>
+
+IncrementalHistogram::IncrementalHistogram()
+    : channels_(0), total_(0)
+{
+    for (HistogramProcessor::HistogramCounts& channel_counts : counts_)
+    {
+        channel_counts.fill(0);
+    }
+}
+
+IncrementalHistogram::~IncrementalHistogram()
+{
+}
+
+bool IncrementalHistogram::reset(const cv::Mat& img)
+{
+    if (img.empty() || (img.type() != CV_8UC1 && img.type() != CV_8UC3))
+    {
+        std::cerr << "Erro: Imagem deve ser CV_8UC1 ou CV_8UC3!" << std::endl;
+        return false;
+    }
+
+    for (HistogramProcessor::HistogramCounts& channel_counts : counts_)
+    {
+        channel_counts.fill(0);
+    }
+    channels_ = img.channels();
+    total_ = 0;
+
+    return add_region(img, cv::Rect(0, 0, img.cols, img.rows));
+}
+
+bool IncrementalHistogram::count_region(const cv::Mat& img, const cv::Rect& region, std::vector<uint32_t>& local) const
+{
+    if (channels_ == 0)
+    {
+        std::cerr << "Erro: Histograma incremental não inicializado (use reset)!" << std::endl;
+        return false;
+    }
+
+    if (img.empty() || img.depth() != CV_8U || img.channels() != channels_)
+    {
+        std::cerr << "Erro: Imagem deve ser de 8 bits com " << channels_ << " canal(is)!" << std::endl;
+        return false;
+    }
+
+    if (region.x < 0 || region.y < 0 || region.width < 0 || region.height < 0 ||
+        region.x + region.width > img.cols || region.y + region.height > img.rows)
+    {
+        std::cerr << "Erro: Região fora dos limites da imagem!" << std::endl;
+        return false;
+    }
+
+    // Contadores de 32 bits: regiões com até 2^32 - 1 pixels
+    local.assign(static_cast<size_t>(channels_) * 256, 0);
+    for (int linha = region.y; linha < region.y + region.height; linha++)
+    {
+        const uchar* pixel = img.ptr<uchar>(linha) + static_cast<size_t>(region.x) * channels_;
+        if (channels_ == 1)
+        {
+            for (int coluna = 0; coluna < region.width; coluna++)
+            {
+                local[pixel[coluna]]++;
+            }
+        }
+        else
+        {
+            for (int coluna = 0; coluna < region.width; coluna++, pixel += 3)
+            {
+                local[pixel[0]]++;
+                local[256 + pixel[1]]++;
+                local[512 + pixel[2]]++;
+            }
+        }
+    }
+    return true;
+}
+
+bool IncrementalHistogram::add_region(const cv::Mat& img, const cv::Rect& region)
+{
+    std::vector<uint32_t> local;
+    if (!count_region(img, region, local))
+    {
+        return false;
+    }
+
+    for (int canal = 0; canal < channels_; canal++)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            counts_[canal][i] += local[canal * 256 + i];
+        }
+    }
+    total_ += static_cast<uint64_t>(region.width) * region.height;
+    return true;
+}
+
+bool IncrementalHistogram::remove_region(const cv::Mat& img, const cv::Rect& region)
+{
+    std::vector<uint32_t> local;
+    if (!count_region(img, region, local))
+    {
+        return false;
+    }
+
+    // Verifica antes de alterar: nenhum contador pode ficar negativo
+    for (int canal = 0; canal < channels_; canal++)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            if (local[canal * 256 + i] > counts_[canal][i])
+            {
+                std::cerr << "Erro: Região removida não corresponde ao conteúdo do histograma!" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    for (int canal = 0; canal < channels_; canal++)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            counts_[canal][i] -= local[canal * 256 + i];
+        }
+    }
+    total_ -= static_cast<uint64_t>(region.width) * region.height;
+    return true;
+}
+
+bool IncrementalHistogram::replace_region(const cv::Mat& old_pixels, const cv::Mat& new_pixels)
+{
+    if (old_pixels.rows != new_pixels.rows || old_pixels.cols != new_pixels.cols ||
+        old_pixels.type() != new_pixels.type())
+    {
+        std::cerr << "Erro: Conteúdo antigo e novo devem ter o mesmo tamanho e tipo!" << std::endl;
+        return false;
+    }
+
+    const cv::Rect whole(0, 0, new_pixels.cols, new_pixels.rows);
+    if (!remove_region(old_pixels, whole))
+    {
+        return false;
+    }
+    if (!add_region(new_pixels, whole))
+    {
+        // Restaura o estado anterior (a remoção já foi aplicada)
+        add_region(old_pixels, whole);
+        return false;
+    }
+    return true;
+}
+
+std::vector<int> IncrementalHistogram::histogram(int channel) const
+{
+    if (channel < 0 || channel >= channels_)
+    {
+        std::cerr << "Erro: Canal inválido!" << std::endl;
+        return std::vector<int>();
+    }
+    return std::vector<int>(counts_[channel].begin(), counts_[channel].end());
+}
+
+const HistogramProcessor::HistogramCounts& IncrementalHistogram::counts(int channel) const
+{
+    return counts_[std::min(std::max(channel, 0), 2)];
+}
+
+int IncrementalHistogram::channels() const
+{
+    return channels_;
+}
+
+uint64_t IncrementalHistogram::total() const
+{
+    return total_;
+}
@@ -0,0 +1,161 @@
+#include "histo/integral_histogram.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    /**
+     * Deslocamento que leva um valor de 8 bits ao seu bin.
+     * @return 8 - log2(bins), ou -1 se bins não for potência de 2 em [1, 256]
+     */
+    int bin_shift(int bins)
+    {
+        for (int shift = 0; shift <= 8; shift++)
+        {
+            if ((256 >> shift) == bins)
+            {
+                return shift;
+            }
+        }
+        return -1;
+    }
+}
+
+IntegralHistogram::IntegralHistogram()
+    : rows_(0), cols_(0), bins_(0), shift_(0)
+{
+}
+
+IntegralHistogram::~IntegralHistogram()
+{
+}
+
+size_t IntegralHistogram::estimate_memory(int rows, int cols, int bins)
+{
+    if (rows <= 0 || cols <= 0 || bin_shift(bins) < 0)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(rows + 1) * static_cast<size_t>(cols + 1) * bins * sizeof(uint32_t);
+}
+
+bool IntegralHistogram::build(const cv::Mat& img, int bins)
+{
+    if (img.empty() || img.type() != CV_8UC1)
+    {
+        std::cerr << "Erro: Imagem deve ser em tons de cinza (CV_8UC1)!" << std::endl;
+        return false;
+    }
+
+    const int shift = bin_shift(bins);
+    if (shift < 0)
+    {
+        std::cerr << "Erro: Número de bins deve ser potência de 2 entre 1 e 256!" << std::endl;
+        return false;
+    }
+
+    // Contadores de 32 bits: o total de pixels precisa caber neles
+    if (img.total() > UINT32_MAX)
+    {
+        std::cerr << "Erro: Imagem grande demais para o histograma integral!" << std::endl;
+        return false;
+    }
+
+    rows_ = img.rows;
+    cols_ = img.cols;
+    bins_ = bins;
+    shift_ = shift;
+
+    const size_t row_stride = static_cast<size_t>(cols_ + 1) * bins_;
+    table_.assign(static_cast<size_t>(rows_ + 1) * row_stride, 0);
+
+    // 1) Somas prefixas horizontais: cada linha é independente
+    cv::parallel_for_(cv::Range(0, rows_), [&](const cv::Range& faixa)
+    {
+        for (int linha = faixa.start; linha < faixa.end; linha++)
+        {
+            const uchar* pixel = img.ptr<uchar>(linha);
+            uint32_t* cell = table_.data() + static_cast<size_t>(linha + 1) * row_stride;
+
+            for (int coluna = 0; coluna < cols_; coluna++)
+            {
+                uint32_t* next = cell + bins_;
+                std::memcpy(next, cell, bins_ * sizeof(uint32_t));
+                next[pixel[coluna] >> shift_]++;
+                cell = next;
+            }
+        }
+    });
+
+    // 2) Somas acumuladas verticais: faixas de colunas (x bins) independentes
+    cv::parallel_for_(cv::Range(0, static_cast<int>(row_stride)), [&](const cv::Range& faixa)
+    {
+        for (int linha = 2; linha <= rows_; linha++)
+        {
+            uint32_t* current = table_.data() + static_cast<size_t>(linha) * row_stride;
+            const uint32_t* above = current - row_stride;
+            for (int i = faixa.start; i < faixa.end; i++)
+            {
+                current[i] += above[i];
+            }
+        }
+    });
+
+    return true;
+}
+
+bool IntegralHistogram::query(const cv::Rect& region, std::vector<int>& histogram) const
+{
+    if (empty())
+    {
+        std::cerr << "Erro: Histograma integral não construído!" << std::endl;
+        return false;
+    }
+
+    if (region.x < 0 || region.y < 0 || region.width < 0 || region.height < 0 ||
+        region.x + region.width > cols_ || region.y + region.height > rows_)
+    {
+        std::cerr << "Erro: Retângulo fora dos limites da imagem!" << std::endl;
+        return false;
+    }
+
+    const size_t row_stride = static_cast<size_t>(cols_ + 1) * bins_;
+    const uint32_t* top = table_.data() + static_cast<size_t>(region.y) * row_stride;
+    const uint32_t* bottom = table_.data() + static_cast<size_t>(region.y + region.height) * row_stride;
+    const size_t left = static_cast<size_t>(region.x) * bins_;
+    const size_t right = static_cast<size_t>(region.x + region.width) * bins_;
+
+    // H = D - B - C + A, bin a bin (laço simples, vetorizado pelo compilador)
+    histogram.resize(bins_);
+    for (int b = 0; b < bins_; b++)
+    {
+        histogram[b] = static_cast<int>(bottom[right + b] - bottom[left + b] - top[right + b] + top[left + b]);
+    }
+    return true;
+}
+
+std::vector<int> IntegralHistogram::query(const cv::Rect& region) const
+{
+    std::vector<int> histogram;
+    if (!query(region, histogram))
+    {
+        histogram.clear();
+    }
+    return histogram;
+}
+
+int IntegralHistogram::bins() const
+{
+    return bins_;
+}
+
+bool IntegralHistogram::empty() const
+{
+    return table_.empty();
+}
+
+size_t IntegralHistogram::memory_bytes() const
+{
+    return table_.size() * sizeof(uint32_t);
+}
@@ -0,0 +1,262 @@
+#include "lut/point_lut.hpp"
+#include <iostream>
+
+#if defined(__AVX512VBMI__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__AVX512VBMI__)
+    /**
+     * Carrega uma tabela de 256 entradas em quatro registradores de 64 bytes.
+     */
+    inline void load_table_512(const uchar* table, __m512i quarters[4])
+    {
+        for (int q = 0; q < 4; q++)
+        {
+            quarters[q] = _mm512_loadu_si512(reinterpret_cast<const void*>(table + 64 * q));
+        }
+    }
+
+    /**
+     * Consulta 64 bytes de uma vez: permutex2var resolve os 7 bits inferiores
+     * em cada metade da tabela e o bit 7 escolhe entre as duas metades.
+     */
+    inline __m512i lookup_512(const __m512i quarters[4], __m512i idx)
+    {
+        __m512i low_half = _mm512_permutex2var_epi8(quarters[0], idx, quarters[1]);
+        __m512i high_half = _mm512_permutex2var_epi8(quarters[2], idx, quarters[3]);
+        return _mm512_mask_blend_epi8(_mm512_movepi8_mask(idx), low_half, high_half);
+    }
+#endif
+
+    /**
+     * Aplica uma tabela única a n bytes consecutivos.
+     * Sem AVX-512 VBMI usa laço escalar desenrolado: consultas de 256 entradas
+     * por pshufb (SSSE3/AVX2) exigem 16 embaralhamentos por vetor e não
+     * superam a leitura direta da tabela.
+     */
+    void lookup_u8(const uchar* table, const uchar* src, uchar* dst, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX512VBMI__)
+        __m512i quarters[4];
+        load_table_512(table, quarters);
+        for (; i + 64 <= n; i += 64)
+        {
+            __m512i idx = _mm512_loadu_si512(reinterpret_cast<const void*>(src + i));
+            _mm512_storeu_si512(reinterpret_cast<void*>(dst + i), lookup_512(quarters, idx));
+        }
+#endif
+        for (; i + 4 <= n; i += 4)
+        {
+            dst[i] = table[src[i]];
+            dst[i + 1] = table[src[i + 1]];
+            dst[i + 2] = table[src[i + 2]];
+            dst[i + 3] = table[src[i + 3]];
+        }
+        for (; i < n; i++)
+        {
+            dst[i] = table[src[i]];
+        }
+    }
+
+    /**
+     * Aplica uma tabela por canal a n bytes BGR intercalados (n múltiplo de 3,
+     * começando no canal azul).
+     */
+    void lookup_bgr_u8(const PointLut::Table* tables, const uchar* src, uchar* dst, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX512VBMI__)
+        __m512i quarters[3][4];
+        for (int canal = 0; canal < 3; canal++)
+        {
+            load_table_512(tables[canal].data(), quarters[canal]);
+        }
+
+        // 64 = 1 (mod 3): o canal do primeiro byte avança uma posição a cada
+        // vetor, então bastam três pares de máscaras (G e R; B é o restante).
+        __mmask64 green_mask[3] = { 0, 0, 0 };
+        __mmask64 red_mask[3] = { 0, 0, 0 };
+        for (int fase = 0; fase < 3; fase++)
+        {
+            for (int j = 0; j < 64; j++)
+            {
+                int canal = (fase + j) % 3;
+                if (canal == 1) green_mask[fase] |= (1ULL << j);
+                if (canal == 2) red_mask[fase] |= (1ULL << j);
+            }
+        }
+
+        for (int fase = 0; i + 64 <= n; i += 64, fase = (fase + 1) % 3)
+        {
+            __m512i idx = _mm512_loadu_si512(reinterpret_cast<const void*>(src + i));
+            __m512i out = lookup_512(quarters[0], idx);
+            out = _mm512_mask_blend_epi8(green_mask[fase], out, lookup_512(quarters[1], idx));
+            out = _mm512_mask_blend_epi8(red_mask[fase], out, lookup_512(quarters[2], idx));
+            _mm512_storeu_si512(reinterpret_cast<void*>(dst + i), out);
+        }
+#endif
+        const uchar* lut[3] = { tables[0].data(), tables[1].data(), tables[2].data() };
+        int canal = static_cast<int>(i % 3);
+        for (; i < n; i++)
+        {
+            dst[i] = lut[canal][src[i]];
+            canal = (canal == 2) ? 0 : canal + 1;
+        }
+    }
+}
+
+PointLut::PointLut()
+    : per_channel_(false), empty_(false)
+{
+    for (int v = 0; v < 256; v++)
+    {
+        tables_[0][v] = static_cast<uchar>(v);
+    }
+    tables_[1] = tables_[0];
+    tables_[2] = tables_[0];
+}
+
+PointLut::PointLut(const Table& table)
+    : per_channel_(false), empty_(false)
+{
+    tables_[0] = table;
+    tables_[1] = table;
+    tables_[2] = table;
+}
+
+PointLut::PointLut(const Table& blue_table, const Table& green_table, const Table& red_table)
+    : per_channel_(true), empty_(false)
+{
+    tables_[0] = blue_table;
+    tables_[1] = green_table;
+    tables_[2] = red_table;
+}
+
+PointLut PointLut::from_function(const std::function<uchar(uchar)>& func)
+{
+    Table table;
+    for (int v = 0; v < 256; v++)
+    {
+        table[v] = func(static_cast<uchar>(v));
+    }
+    return PointLut(table);
+}
+
+PointLut PointLut::invalid()
+{
+    PointLut lut;
+    lut.empty_ = true;
+    return lut;
+}
+
+bool PointLut::empty() const
+{
+    return empty_;
+}
+
+bool PointLut::is_per_channel() const
+{
+    return per_channel_;
+}
+
+const PointLut::Table& PointLut::table(int channel) const
+{
+    if (!per_channel_ || channel < 0 || channel > 2)
+    {
+        return tables_[0];
+    }
+    return tables_[channel];
+}
+
+PointLut PointLut::then(const PointLut& next) const
+{
+    if (empty_ || next.empty_)
+    {
+        return invalid();
+    }
+
+    std::array<Table, 3> composed;
+    for (int canal = 0; canal < 3; canal++)
+    {
+        const Table& first = table(canal);
+        const Table& second = next.table(canal);
+        for (int v = 0; v < 256; v++)
+        {
+            composed[canal][v] = second[first[v]];
+        }
+    }
+
+    if (!per_channel_ && !next.per_channel_)
+    {
+        return PointLut(composed[0]);
+    }
+    return PointLut(composed[0], composed[1], composed[2]);
+}
+
+cv::Mat PointLut::apply(const cv::Mat& img) const
+{
+    cv::Mat result;
+    if (!apply(img, result))
+    {
+        return cv::Mat();
+    }
+    return result;
+}
+
+bool PointLut::apply(const cv::Mat& img, cv::Mat& result) const
+{
+    if (empty_)
+    {
+        std::cerr << "Erro: Tabela de consulta inválida (operação sem resultado definido)!" << std::endl;
+        return false;
+    }
+
+    if (img.empty())
+    {
+        std::cerr << "Erro: Imagem vazia!" << std::endl;
+        return false;
+    }
+
+    if (img.type() != CV_8UC1 && img.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+        return false;
+    }
+
+    if (per_channel_ && img.channels() != 3)
+    {
+        std::cerr << "Erro: Tabela por canal exige imagem colorida (3 canais)!" << std::endl;
+        return false;
+    }
+
+    result.create(img.rows, img.cols, img.type());
+
+    const bool use_bgr = per_channel_;
+    const size_t row_bytes = static_cast<size_t>(img.cols) * img.elemSize();
+
+    // Imagens contínuas são tratadas como um único vetor de bytes; ROIs linha a linha.
+    const bool continuous = img.isContinuous() && result.isContinuous();
+    const int spans = continuous ? 1 : img.rows;
+    const size_t span_bytes = continuous ? row_bytes * img.rows : row_bytes;
+
+    for (int linha = 0; linha < spans; linha++)
+    {
+        const uchar* pixel_in = img.ptr<uchar>(linha);
+        uchar* pixel_out = result.ptr<uchar>(linha);
+
+        if (use_bgr)
+        {
+            lookup_bgr_u8(tables_.data(), pixel_in, pixel_out, span_bytes);
+        }
+        else
+        {
+            lookup_u8(tables_[0].data(), pixel_in, pixel_out, span_bytes);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,268 @@
+#include "seg/connected_components.hpp"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+namespace
+{
+    /**
+     * Estatísticas parciais de um rótulo provisório.
+     */
+    struct BlobAccumulator
+    {
+        long long area = 0;
+        long long sum_x = 0;
+        long long sum_y = 0;
+        int min_x = INT_MAX;
+        int min_y = INT_MAX;
+        int max_x = -1;
+        int max_y = -1;
+
+        void add(int x, int y)
+        {
+            area++;
+            sum_x += x;
+            sum_y += y;
+            min_x = std::min(min_x, x);
+            min_y = std::min(min_y, y);
+            max_x = std::max(max_x, x);
+            max_y = std::max(max_y, y);
+        }
+
+        void merge(const BlobAccumulator& other)
+        {
+            area += other.area;
+            sum_x += other.sum_x;
+            sum_y += other.sum_y;
+            min_x = std::min(min_x, other.min_x);
+            min_y = std::min(min_y, other.min_y);
+            max_x = std::max(max_x, other.max_x);
+            max_y = std::max(max_y, other.max_y);
+        }
+    };
+
+    /**
+     * Raiz de um rótulo com compressão por "path halving".
+     * Invariante: parent[l] <= l (a raiz é sempre o menor rótulo do conjunto).
+     */
+    inline int find_root(std::vector<int>& parent, int l)
+    {
+        while (parent[l] != l)
+        {
+            parent[l] = parent[parent[l]];
+            l = parent[l];
+        }
+        return l;
+    }
+
+    /**
+     * Une dois conjuntos ligando a maior raiz à menor.
+     * @return Raiz resultante
+     */
+    inline int unite(std::vector<int>& parent, int a, int b)
+    {
+        a = find_root(parent, a);
+        b = find_root(parent, b);
+        if (a < b)
+        {
+            parent[b] = a;
+            return a;
+        }
+        parent[a] = b;
+        return b;
+    }
+
+    /**
+     * Faixa de linhas e seu intervalo de rótulos provisórios.
+     */
+    struct Strip
+    {
+        int row_begin;
+        int row_end;
+        int label_base;                         // Rótulos em (label_base, label_base + bound]
+        std::vector<BlobAccumulator> blobs;     // blobs[k] -> rótulo label_base + 1 + k
+    };
+}
+
+ConnectedComponents::ConnectedComponents()
+{
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+}
+
+int ConnectedComponents::label_components(const cv::Mat& binary, cv::Mat& labels, std::vector<BlobStats>& stats,
+                                          Connectivity connectivity)
+{
+    stats.clear();
+
+    if (binary.empty())
+    {
+        std::cerr << "Erro: Imagem vazia!" << std::endl;
+        return -1;
+    }
+
+    if (binary.type() != CV_8UC1)
+    {
+        std::cerr << "Erro: Imagem binária deve ser CV_8UC1!" << std::endl;
+        return -1;
+    }
+
+    const int rows = binary.rows;
+    const int cols = binary.cols;
+    const bool eight = (connectivity == CONNECTIVITY_8);
+
+    labels.create(rows, cols, CV_32SC1);
+
+    // Divide em faixas de pelo menos 16 linhas, uma por thread.
+    // Um novo rótulo só nasce sem vizinho à esquerda, então cada linha cria
+    // no máximo ceil(cols / 2) rótulos: esse é o limite do intervalo da faixa.
+    const int num_strips = std::max(1, std::min(cv::getNumThreads(), rows / 16));
+    const int labels_per_row = (cols + 1) / 2;
+    std::vector<Strip> strips(num_strips);
+    int label_base = 0;
+    for (int s = 0; s < num_strips; s++)
+    {
+        strips[s].row_begin = static_cast<int>(static_cast<long long>(rows) * s / num_strips);
+        strips[s].row_end = static_cast<int>(static_cast<long long>(rows) * (s + 1) / num_strips);
+        strips[s].label_base = label_base;
+        label_base += (strips[s].row_end - strips[s].row_begin) * labels_per_row;
+    }
+
+    std::vector<int> parent(static_cast<size_t>(label_base) + 1);
+    parent[0] = 0;
+
+    // 1) Rotulação provisória de cada faixa em paralelo (intervalos disjuntos
+    //    de rótulos: as threads nunca tocam a mesma entrada de parent)
+    cv::parallel_for_(cv::Range(0, num_strips), [&](const cv::Range& faixa)
+    {
+        for (int s = faixa.start; s < faixa.end; s++)
+        {
+            Strip& strip = strips[s];
+            int next_label = strip.label_base;
+
+            for (int linha = strip.row_begin; linha < strip.row_end; linha++)
+            {
+                const uchar* pixel = binary.ptr<uchar>(linha);
+                int* label_row = labels.ptr<int>(linha);
+                const int* label_above = (linha > strip.row_begin) ? labels.ptr<int>(linha - 1) : nullptr;
+
+                for (int coluna = 0; coluna < cols; coluna++)
+                {
+                    if (pixel[coluna] == 0)
+                    {
+                        label_row[coluna] = 0;
+                        continue;
+                    }
+
+                    int current = 0;
+                    auto connect = [&](int neighbor)
+                    {
+                        if (neighbor == 0) return;
+                        current = (current == 0) ? neighbor : unite(parent, current, neighbor);
+                    };
+
+                    if (coluna > 0) connect(label_row[coluna - 1]);
+                    if (label_above)
+                    {
+                        connect(label_above[coluna]);
+                        if (eight)
+                        {
+                            if (coluna > 0) connect(label_above[coluna - 1]);
+                            if (coluna + 1 < cols) connect(label_above[coluna + 1]);
+                        }
+                    }
+
+                    if (current == 0)
+                    {
+                        current = ++next_label;
+                        parent[current] = current;
+                        strip.blobs.emplace_back();
+                    }
+
+                    label_row[coluna] = current;
+                    // Estatísticas acumuladas no rótulo provisório, na mesma passada
+                    strip.blobs[current - strip.label_base - 1].add(coluna, linha);
+                }
+            }
+        }
+    }, num_strips);
+
+    // 2) União das fronteiras entre faixas consecutivas
+    for (int s = 1; s < num_strips; s++)
+    {
+        const int linha = strips[s].row_begin;
+        const uchar* pixel = binary.ptr<uchar>(linha);
+        const int* label_row = labels.ptr<int>(linha);
+        const int* label_above = labels.ptr<int>(linha - 1);
+
+        for (int coluna = 0; coluna < cols; coluna++)
+        {
+            if (pixel[coluna] == 0) continue;
+
+            if (label_above[coluna]) unite(parent, label_row[coluna], label_above[coluna]);
+            if (eight)
+            {
+                if (coluna > 0 && label_above[coluna - 1]) unite(parent, label_row[coluna], label_above[coluna - 1]);
+                if (coluna + 1 < cols && label_above[coluna + 1]) unite(parent, label_row[coluna], label_above[coluna + 1]);
+            }
+        }
+    }
+
+    // 3) Compactação para 1..N em ordem crescente: como parent[l] <= l, ao
+    //    visitar l todos os rótulos menores já guardam seu índice final.
+    int count = 0;
+    for (const Strip& strip : strips)
+    {
+        const int first = strip.label_base + 1;
+        const int last = strip.label_base + static_cast<int>(strip.blobs.size());
+        for (int l = first; l <= last; l++)
+        {
+            parent[l] = (parent[l] < l) ? parent[parent[l]] : ++count;
+        }
+    }
+
+    std::vector<BlobAccumulator> merged(count);
+    for (const Strip& strip : strips)
+    {
+        for (size_t k = 0; k < strip.blobs.size(); k++)
+        {
+            merged[parent[strip.label_base + 1 + k] - 1].merge(strip.blobs[k]);
+        }
+    }
+
+    // 4) Reescrita dos rótulos finais em paralelo
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& faixa)
+    {
+        for (int linha = faixa.start; linha < faixa.end; linha++)
+        {
+            int* label_row = labels.ptr<int>(linha);
+            for (int coluna = 0; coluna < cols; coluna++)
+            {
+                label_row[coluna] = parent[label_row[coluna]];
+            }
+        }
+    });
+
+    stats.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        const BlobAccumulator& acc = merged[i];
+        stats[i].label = i + 1;
+        stats[i].area = static_cast<int>(acc.area);
+        stats[i].centroid_x = static_cast<double>(acc.sum_x) / acc.area;
+        stats[i].centroid_y = static_cast<double>(acc.sum_y) / acc.area;
+        stats[i].bounding_box = cv::Rect(acc.min_x, acc.min_y, acc.max_x - acc.min_x + 1, acc.max_y - acc.min_y + 1);
+    }
+
+    return count;
+}
+
+std::vector<ConnectedComponents::BlobStats> ConnectedComponents::compute_blob_stats(const cv::Mat& binary, Connectivity connectivity)
+{
+    cv::Mat labels;
+    std::vector<BlobStats> stats;
+    label_components(binary, labels, stats, connectivity);
+    return stats;
+}
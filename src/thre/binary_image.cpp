@@ -0,0 +1,202 @@
+#include "thre/binary_image.hpp"
+#include <iostream>
+
+#if defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Conta bits ligados em uma palavra (instrução POPCNT quando disponível).
+     */
+    inline int popcount64(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+}
+
+BinaryImage::BinaryImage()
+    : rows_(0), cols_(0), words_per_row_(0)
+{
+}
+
+BinaryImage::BinaryImage(int rows, int cols)
+    : rows_(0), cols_(0), words_per_row_(0)
+{
+    if (rows < 0 || cols < 0)
+    {
+        std::cerr << "Erro: Dimensões negativas para a máscara binária!" << std::endl;
+        return;
+    }
+
+    rows_ = rows;
+    cols_ = cols;
+    words_per_row_ = (cols + 63) / 64;
+    bits_.assign(static_cast<size_t>(rows) * words_per_row_, 0);
+}
+
+BinaryImage::~BinaryImage()
+{
+}
+
+// ================ Acesso ================
+
+int BinaryImage::rows() const
+{
+    return rows_;
+}
+
+int BinaryImage::cols() const
+{
+    return cols_;
+}
+
+bool BinaryImage::empty() const
+{
+    return rows_ == 0 || cols_ == 0;
+}
+
+int BinaryImage::words_per_row() const
+{
+    return words_per_row_;
+}
+
+uint64_t* BinaryImage::row_ptr(int linha)
+{
+    return bits_.data() + static_cast<size_t>(linha) * words_per_row_;
+}
+
+const uint64_t* BinaryImage::row_ptr(int linha) const
+{
+    return bits_.data() + static_cast<size_t>(linha) * words_per_row_;
+}
+
+bool BinaryImage::get(int linha, int coluna) const
+{
+    return (row_ptr(linha)[coluna >> 6] >> (coluna & 63)) & 1ULL;
+}
+
+void BinaryImage::set(int linha, int coluna, bool value)
+{
+    uint64_t bit = 1ULL << (coluna & 63);
+    uint64_t& word = row_ptr(linha)[coluna >> 6];
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+uint64_t BinaryImage::tail_mask() const
+{
+    int used = cols_ & 63;
+    return (used == 0) ? ~0ULL : ((1ULL << used) - 1);
+}
+
+// ================ Operações lógicas ================
+
+template <typename Op>
+BinaryImage BinaryImage::combine(const BinaryImage& other, Op op) const
+{
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+    {
+        std::cerr << "Erro: Máscaras binárias com dimensões diferentes!" << std::endl;
+        return BinaryImage();
+    }
+
+    BinaryImage result(rows_, cols_);
+    for (size_t i = 0; i < bits_.size(); i++)
+    {
+        result.bits_[i] = op(bits_[i], other.bits_[i]);
+    }
+    return result;
+}
+
+BinaryImage BinaryImage::logical_and(const BinaryImage& other) const
+{
+    return combine(other, [](uint64_t a, uint64_t b) { return a & b; });
+}
+
+BinaryImage BinaryImage::logical_or(const BinaryImage& other) const
+{
+    return combine(other, [](uint64_t a, uint64_t b) { return a | b; });
+}
+
+BinaryImage BinaryImage::logical_xor(const BinaryImage& other) const
+{
+    return combine(other, [](uint64_t a, uint64_t b) { return a ^ b; });
+}
+
+BinaryImage BinaryImage::logical_not() const
+{
+    BinaryImage result(rows_, cols_);
+    if (words_per_row_ == 0)
+    {
+        return result;
+    }
+    const uint64_t last_mask = tail_mask();
+
+    for (int linha = 0; linha < rows_; linha++)
+    {
+        const uint64_t* word_in = row_ptr(linha);
+        uint64_t* word_out = result.row_ptr(linha);
+        for (int w = 0; w < words_per_row_; w++)
+        {
+            word_out[w] = ~word_in[w];
+        }
+        // Mantém zerados os bits de preenchimento
+        word_out[words_per_row_ - 1] &= last_mask;
+    }
+    return result;
+}
+
+// ================ Contagem e conversão ================
+
+size_t BinaryImage::count_nonzero() const
+{
+    size_t total = 0;
+    for (uint64_t word : bits_)
+    {
+        total += popcount64(word);
+    }
+    return total;
+}
+
+cv::Mat BinaryImage::to_mat(uchar on_value) const
+{
+    if (empty())
+    {
+        std::cerr << "Erro: Imagem binária vazia!" << std::endl;
+        return cv::Mat();
+    }
+
+    cv::Mat result(rows_, cols_, CV_8UC1);
+
+    for (int linha = 0; linha < rows_; linha++)
+    {
+        const uint64_t* word_in = row_ptr(linha);
+        uchar* pixel_out = result.ptr<uchar>(linha);
+
+        int coluna = 0;
+#if defined(__AVX512BW__)
+        // Cada palavra vira 64 bytes de uma vez: máscara -> 0xFF/0x00 -> and com on_value
+        const __m512i on512 = _mm512_set1_epi8(static_cast<char>(on_value));
+        for (; coluna + 64 <= cols_; coluna += 64)
+        {
+            __m512i bytes = _mm512_maskz_mov_epi8(static_cast<__mmask64>(word_in[coluna >> 6]), on512);
+            _mm512_storeu_si512(reinterpret_cast<void*>(pixel_out + coluna), bytes);
+        }
+#endif
+        for (; coluna < cols_; coluna++)
+        {
+            pixel_out[coluna] = ((word_in[coluna >> 6] >> (coluna & 63)) & 1ULL) ? on_value : 0;
+        }
+    }
+
+    return result;
+}
@@ -1,5 +1,416 @@
 #include "thre/threshold.hpp"
+#include "conv/grayscale.hpp"
+#include "histo/histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    typedef ThresholdOperations::ThresholdType ThresholdType;
+
+    /**
+     * Limiarização escalar de um byte, resolvida em tempo de compilação
+     * (sem switch por pixel). Usada na cauda dos kernels vetoriais.
+     */
+    template <ThresholdType Type>
+    inline uchar threshold_scalar(uchar v, uchar thresh, uchar max_value)
+    {
+        const bool above = v > thresh;
+        if constexpr (Type == ThresholdOperations::BINARY) return above ? max_value : 0;
+        else if constexpr (Type == ThresholdOperations::BINARY_INV) return above ? 0 : max_value;
+        else if constexpr (Type == ThresholdOperations::TRUNCATE) return above ? thresh : v;
+        else if constexpr (Type == ThresholdOperations::TO_ZERO) return above ? v : 0;
+        else return above ? 0 : v;
+    }
+
+#if defined(__SSE2__)
+    /**
+     * Combina a máscara "v > thresh" (0xFF/0x00 por byte) com o valor do
+     * pixel conforme o tipo, sem desvios: and/andnot/min.
+     */
+    template <ThresholdType Type>
+    inline __m128i threshold_blend_128(__m128i v, __m128i above, __m128i thresh, __m128i max_value)
+    {
+        if constexpr (Type == ThresholdOperations::BINARY) return _mm_and_si128(above, max_value);
+        else if constexpr (Type == ThresholdOperations::BINARY_INV) return _mm_andnot_si128(above, max_value);
+        else if constexpr (Type == ThresholdOperations::TRUNCATE) return _mm_min_epu8(v, thresh);
+        else if constexpr (Type == ThresholdOperations::TO_ZERO) return _mm_and_si128(above, v);
+        else return _mm_andnot_si128(above, v);
+    }
+#endif
+
+#if defined(__AVX2__)
+    template <ThresholdType Type>
+    inline __m256i threshold_blend_256(__m256i v, __m256i above, __m256i thresh, __m256i max_value)
+    {
+        if constexpr (Type == ThresholdOperations::BINARY) return _mm256_and_si256(above, max_value);
+        else if constexpr (Type == ThresholdOperations::BINARY_INV) return _mm256_andnot_si256(above, max_value);
+        else if constexpr (Type == ThresholdOperations::TRUNCATE) return _mm256_min_epu8(v, thresh);
+        else if constexpr (Type == ThresholdOperations::TO_ZERO) return _mm256_and_si256(above, v);
+        else return _mm256_andnot_si256(above, v);
+    }
+#endif
+
+#if defined(__AVX512BW__)
+    template <ThresholdType Type>
+    inline __m512i threshold_blend_512(__m512i v, __mmask64 above, __m512i thresh, __m512i max_value)
+    {
+        if constexpr (Type == ThresholdOperations::BINARY) return _mm512_maskz_mov_epi8(above, max_value);
+        else if constexpr (Type == ThresholdOperations::BINARY_INV) return _mm512_maskz_mov_epi8(~above, max_value);
+        else if constexpr (Type == ThresholdOperations::TRUNCATE) return _mm512_min_epu8(v, thresh);
+        else if constexpr (Type == ThresholdOperations::TO_ZERO) return _mm512_maskz_mov_epi8(above, v);
+        else return _mm512_maskz_mov_epi8(~above, v);
+    }
+#endif
+
+    /**
+     * Aplica a limiarização do tipo Type a n bytes consecutivos.
+     * Comparação sem sinal "v > thresh" calculada como v != min(v, thresh)
+     * (SSE2/AVX2 não têm comparação de bytes sem sinal) ou por máscara (AVX-512).
+     */
+    template <ThresholdType Type>
+    void threshold_span(const uchar* src, uchar* dst, size_t n, uchar thresh, uchar max_value)
+    {
+        size_t i = 0;
+#if defined(__AVX512BW__)
+        const __m512i thresh512 = _mm512_set1_epi8(static_cast<char>(thresh));
+        const __m512i max512 = _mm512_set1_epi8(static_cast<char>(max_value));
+        for (; i + 64 <= n; i += 64)
+        {
+            __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(src + i));
+            __mmask64 above = _mm512_cmpgt_epu8_mask(v, thresh512);
+            _mm512_storeu_si512(reinterpret_cast<void*>(dst + i), threshold_blend_512<Type>(v, above, thresh512, max512));
+        }
+#endif
+#if defined(__AVX2__)
+        const __m256i thresh256 = _mm256_set1_epi8(static_cast<char>(thresh));
+        const __m256i max256 = _mm256_set1_epi8(static_cast<char>(max_value));
+        const __m256i ones256 = _mm256_set1_epi8(-1);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i above = _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(v, thresh256), v), ones256);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), threshold_blend_256<Type>(v, above, thresh256, max256));
+        }
+#endif
+#if defined(__SSE2__)
+        const __m128i thresh128 = _mm_set1_epi8(static_cast<char>(thresh));
+        const __m128i max128 = _mm_set1_epi8(static_cast<char>(max_value));
+        const __m128i ones128 = _mm_set1_epi8(-1);
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i above = _mm_xor_si128(_mm_cmpeq_epi8(_mm_min_epu8(v, thresh128), v), ones128);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), threshold_blend_128<Type>(v, above, thresh128, max128));
+        }
+#endif
+        for (; i < n; i++)
+        {
+            dst[i] = threshold_scalar<Type>(src[i], thresh, max_value);
+        }
+    }
+
+    /**
+     * Percorre a imagem (1 ou 3 canais, tratada como sequência de bytes)
+     * aplicando o kernel especializado; uma única chamada se contínua.
+     */
+    template <ThresholdType Type>
+    void threshold_image(const cv::Mat& img, cv::Mat& result, uchar thresh, uchar max_value)
+    {
+        const size_t row_bytes = static_cast<size_t>(img.cols) * img.elemSize();
+
+        if (img.isContinuous() && result.isContinuous())
+        {
+            threshold_span<Type>(img.ptr<uchar>(0), result.ptr<uchar>(0), row_bytes * img.rows, thresh, max_value);
+            return;
+        }
+
+        for (int linha = 0; linha < img.rows; linha++)
+        {
+            threshold_span<Type>(img.ptr<uchar>(linha), result.ptr<uchar>(linha), row_bytes, thresh, max_value);
+        }
+    }
+
+    /**
+     * Gera uma linha de BinaryImage: bit x ligado se src[x] > thresh.
+     * AVX-512BW produz a palavra de 64 bits direto da comparação; AVX2/SSE2
+     * juntam 2/4 movemasks. As palavras restantes são montadas em escalar,
+     * com os bits de preenchimento zerados.
+     */
+    void pack_greater_row(const uchar* src, uint64_t* dst, int cols, uchar thresh)
+    {
+        int coluna = 0;
+#if defined(__AVX512BW__)
+        const __m512i thresh512 = _mm512_set1_epi8(static_cast<char>(thresh));
+        for (; coluna + 64 <= cols; coluna += 64)
+        {
+            __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(src + coluna));
+            dst[coluna >> 6] = _mm512_cmpgt_epu8_mask(v, thresh512);
+        }
+#elif defined(__AVX2__)
+        const __m256i thresh256 = _mm256_set1_epi8(static_cast<char>(thresh));
+        for (; coluna + 64 <= cols; coluna += 64)
+        {
+            uint64_t word = 0;
+            for (int parte = 0; parte < 2; parte++)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + coluna + 32 * parte));
+                // cmpeq(min(v, t), v) marca v <= t; o complemento é v > t
+                uint32_t not_above = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(v, thresh256), v)));
+                word |= static_cast<uint64_t>(~not_above) << (32 * parte);
+            }
+            dst[coluna >> 6] = word;
+        }
+#elif defined(__SSE2__)
+        const __m128i thresh128 = _mm_set1_epi8(static_cast<char>(thresh));
+        for (; coluna + 64 <= cols; coluna += 64)
+        {
+            uint64_t word = 0;
+            for (int parte = 0; parte < 4; parte++)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + coluna + 16 * parte));
+                uint32_t not_above = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, thresh128), v)));
+                word |= static_cast<uint64_t>(~not_above & 0xFFFFu) << (16 * parte);
+            }
+            dst[coluna >> 6] = word;
+        }
+#endif
+        for (; coluna < cols; coluna += 64)
+        {
+            const int count = std::min(64, cols - coluna);
+            uint64_t word = 0;
+            for (int k = 0; k < count; k++)
+            {
+                word |= static_cast<uint64_t>(src[coluna + k] > thresh) << k;
+            }
+            dst[coluna >> 6] = word;
+        }
+    }
+
+    /**
+     * Regra de decisão da limiarização adaptativa a partir das somas da janela.
+     */
+    struct LocalRule
+    {
+        bool sauvola;      // false: média - c; true: Sauvola
+        double param;      // c (média) ou k (Sauvola)
+        double range;      // r (Sauvola)
+        uchar max_value;
+    };
+
+    inline uchar local_decision(const LocalRule& rule, uchar v, double sum, double sum_sq, double count)
+    {
+        double mean = sum / count;
+        double thresh;
+        if (rule.sauvola)
+        {
+            double variance = std::max(0.0, sum_sq / count - mean * mean);
+            thresh = mean * (1.0 + rule.param * (std::sqrt(variance) / rule.range - 1.0));
+        }
+        else
+        {
+            thresh = mean - rule.param;
+        }
+        return (v > thresh) ? rule.max_value : 0;
+    }
+
+    /**
+     * Limiarização adaptativa com imagem integral completa ((H+1) x (W+1)).
+     * As somas usam uint32 com aritmética modular: a soma de uma janela é
+     * exata enquanto couber em 32 bits (janelas de até MAX_ADAPTIVE_BLOCK,
+     * validado em adaptive_threshold), mesmo que os totais acumulados
+     * transbordem. Somas dos quadrados em uint64.
+     * Construção e avaliação são paralelas: prefixo horizontal por linha,
+     * acumulação vertical por faixas de colunas e decisão por linhas.
+     */
+    void adaptive_full(const cv::Mat& img, cv::Mat& result, int radius, const LocalRule& rule)
+    {
+        const int rows = img.rows;
+        const int cols = img.cols;
+        const size_t stride = static_cast<size_t>(cols) + 1;
+
+        std::vector<uint32_t> sum(stride * (rows + 1), 0);
+        std::vector<uint64_t> sum_sq(rule.sauvola ? stride * (rows + 1) : 0, 0);
+
+        // 1) Prefixo horizontal de cada linha (independente entre linhas)
+        cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& faixa)
+        {
+            for (int linha = faixa.start; linha < faixa.end; linha++)
+            {
+                const uchar* pixel = img.ptr<uchar>(linha);
+                uint32_t* s_row = &sum[(linha + 1) * stride];
+                uint32_t acc = 0;
+                for (int coluna = 0; coluna < cols; coluna++)
+                {
+                    acc += pixel[coluna];
+                    s_row[coluna + 1] = acc;
+                }
+                if (rule.sauvola)
+                {
+                    uint64_t* q_row = &sum_sq[(linha + 1) * stride];
+                    uint64_t acc_sq = 0;
+                    for (int coluna = 0; coluna < cols; coluna++)
+                    {
+                        acc_sq += static_cast<uint64_t>(pixel[coluna]) * pixel[coluna];
+                        q_row[coluna + 1] = acc_sq;
+                    }
+                }
+            }
+        });
+
+        // 2) Acumulação vertical por faixas de colunas (linhas em ordem)
+        cv::parallel_for_(cv::Range(1, static_cast<int>(stride)), [&](const cv::Range& faixa)
+        {
+            for (int linha = 2; linha <= rows; linha++)
+            {
+                uint32_t* s_row = &sum[linha * stride];
+                const uint32_t* s_prev = &sum[(linha - 1) * stride];
+                for (int coluna = faixa.start; coluna < faixa.end; coluna++)
+                {
+                    s_row[coluna] += s_prev[coluna];
+                }
+                if (rule.sauvola)
+                {
+                    uint64_t* q_row = &sum_sq[linha * stride];
+                    const uint64_t* q_prev = &sum_sq[(linha - 1) * stride];
+                    for (int coluna = faixa.start; coluna < faixa.end; coluna++)
+                    {
+                        q_row[coluna] += q_prev[coluna];
+                    }
+                }
+            }
+        });
+
+        // 3) Decisão por pixel em O(1): quatro acessos à tabela
+        cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& faixa)
+        {
+            for (int linha = faixa.start; linha < faixa.end; linha++)
+            {
+                const int y0 = std::max(0, linha - radius);
+                const int y1 = std::min(rows - 1, linha + radius) + 1;
+                const uint32_t* s_top = &sum[y0 * stride];
+                const uint32_t* s_bottom = &sum[y1 * stride];
+                const uchar* pixel_in = img.ptr<uchar>(linha);
+                uchar* pixel_out = result.ptr<uchar>(linha);
+
+                for (int coluna = 0; coluna < cols; coluna++)
+                {
+                    const int x0 = std::max(0, coluna - radius);
+                    const int x1 = std::min(cols - 1, coluna + radius) + 1;
+                    const uint32_t window = s_bottom[x1] - s_top[x1] - s_bottom[x0] + s_top[x0];
+                    const double count = static_cast<double>(y1 - y0) * (x1 - x0);
+
+                    double window_sq = 0.0;
+                    if (rule.sauvola)
+                    {
+                        const uint64_t* q_top = &sum_sq[y0 * stride];
+                        const uint64_t* q_bottom = &sum_sq[y1 * stride];
+                        window_sq = static_cast<double>(q_bottom[x1] - q_top[x1] - q_bottom[x0] + q_top[x0]);
+                    }
+
+                    pixel_out[coluna] = local_decision(rule, pixel_in[coluna], window, window_sq, count);
+                }
+            }
+        });
+    }
+
+    /**
+     * Limiarização adaptativa com memória limitada: em vez da imagem integral
+     * completa, cada faixa de linhas mantém somas verticais por coluna da
+     * janela corrente (a diferença entre duas linhas da integral), atualizadas
+     * ao deslizar uma linha (+ linha que entra, - linha que sai). O prefixo
+     * horizontal dessas somas fornece a soma da janela em O(1).
+     * Cada faixa reaquece 2 * raio + 1 linhas, então as faixas têm pelo menos
+     * esse tamanho (uma por thread): o custo por pixel continua O(1).
+     * Memória: O(largura) por thread.
+     */
+    void adaptive_band(const cv::Mat& img, cv::Mat& result, int radius, const LocalRule& rule)
+    {
+        const int rows = img.rows;
+        const int cols = img.cols;
+        const int min_rows = 2 * radius + 1;
+        const int num_strips = std::max(1, std::min(cv::getNumThreads(), rows / min_rows));
+
+        cv::parallel_for_(cv::Range(0, num_strips), [&](const cv::Range& faixas)
+        {
+            std::vector<uint32_t> col_sum(cols);
+            std::vector<uint64_t> col_sq(rule.sauvola ? cols : 0);
+            std::vector<uint32_t> prefix(static_cast<size_t>(cols) + 1, 0);
+            std::vector<uint64_t> prefix_sq(rule.sauvola ? static_cast<size_t>(cols) + 1 : 0, 0);
+
+            auto accumulate_row = [&](int linha, bool add)
+            {
+                const uchar* pixel = img.ptr<uchar>(linha);
+                for (int coluna = 0; coluna < cols; coluna++)
+                {
+                    uint32_t v = pixel[coluna];
+                    if (add) col_sum[coluna] += v; else col_sum[coluna] -= v;
+                    if (rule.sauvola)
+                    {
+                        if (add) col_sq[coluna] += v * v; else col_sq[coluna] -= v * v;
+                    }
+                }
+            };
+
+            for (int s = faixas.start; s < faixas.end; s++)
+            {
+                const int row_begin = static_cast<int>(static_cast<long long>(rows) * s / num_strips);
+                const int row_end = static_cast<int>(static_cast<long long>(rows) * (s + 1) / num_strips);
+
+                // Aquecimento: janela vertical da primeira linha da faixa
+                std::fill(col_sum.begin(), col_sum.end(), 0u);
+                std::fill(col_sq.begin(), col_sq.end(), 0ull);
+                for (int linha = std::max(0, row_begin - radius); linha <= std::min(rows - 1, row_begin + radius); linha++)
+                {
+                    accumulate_row(linha, true);
+                }
+
+                for (int linha = row_begin; linha < row_end; linha++)
+                {
+                    if (linha > row_begin)
+                    {
+                        if (linha + radius < rows) accumulate_row(linha + radius, true);
+                        if (linha - radius - 1 >= 0) accumulate_row(linha - radius - 1, false);
+                    }
+
+                    for (int coluna = 0; coluna < cols; coluna++)
+                    {
+                        prefix[coluna + 1] = prefix[coluna] + col_sum[coluna];
+                    }
+                    if (rule.sauvola)
+                    {
+                        for (int coluna = 0; coluna < cols; coluna++)
+                        {
+                            prefix_sq[coluna + 1] = prefix_sq[coluna] + col_sq[coluna];
+                        }
+                    }
+
+                    const int window_rows = std::min(rows - 1, linha + radius) - std::max(0, linha - radius) + 1;
+                    const uchar* pixel_in = img.ptr<uchar>(linha);
+                    uchar* pixel_out = result.ptr<uchar>(linha);
+
+                    for (int coluna = 0; coluna < cols; coluna++)
+                    {
+                        const int x0 = std::max(0, coluna - radius);
+                        const int x1 = std::min(cols - 1, coluna + radius) + 1;
+                        const uint32_t window = prefix[x1] - prefix[x0];
+                        const double window_sq = rule.sauvola ? static_cast<double>(prefix_sq[x1] - prefix_sq[x0]) : 0.0;
+                        const double count = static_cast<double>(window_rows) * (x1 - x0);
+
+                        pixel_out[coluna] = local_decision(rule, pixel_in[coluna], window, window_sq, count);
+                    }
+                }
+            }
+        }, num_strips);
+    }
+}
 
 ThresholdOperations::ThresholdOperations()
 {
@@ -40,6 +451,17 @@ cv::Mat ThresholdOperations::binary_threshold_inv(const cv::Mat& img, uchar thre
     return apply_threshold(img, threshold_value, BINARY_INV, max_value);
 }
 
+cv::Mat ThresholdOperations::binary_threshold_luma(const cv::Mat& img, uchar threshold_value, uchar max_value)
+{
+    GrayScale converter;
+    cv::Mat mask;
+    if (!converter.threshold_weighted(img, mask, threshold_value, max_value))
+    {
+        return cv::Mat();
+    }
+    return mask;
+}
+
 cv::Mat ThresholdOperations::truncate_threshold(const cv::Mat& img, uchar threshold_value)
 {
     return apply_threshold(img, threshold_value, TRUNCATE);
@@ -55,6 +477,43 @@ cv::Mat ThresholdOperations::to_zero_inv_threshold(const cv::Mat& img, uchar thr
     return apply_threshold(img, threshold_value, TO_ZERO_INV);
 }
 
+BinaryImage ThresholdOperations::binary_threshold_packed(const cv::Mat& img, uchar threshold_value)
+{
+    if (img.empty())
+    {
+        std::cerr << "Erro: Imagem vazia!" << std::endl;
+        return BinaryImage();
+    }
+
+    if (img.type() != CV_8UC1)
+    {
+        std::cerr << "Erro: Limiarização compactada exige imagem em tons de cinza (CV_8UC1)!" << std::endl;
+        return BinaryImage();
+    }
+
+    BinaryImage result(img.rows, img.cols);
+
+    cv::parallel_for_(cv::Range(0, img.rows), [&](const cv::Range& faixa)
+    {
+        for (int linha = faixa.start; linha < faixa.end; linha++)
+        {
+            pack_greater_row(img.ptr<uchar>(linha), result.row_ptr(linha), img.cols, threshold_value);
+        }
+    });
+
+    return result;
+}
+
+BinaryImage ThresholdOperations::binary_threshold_inv_packed(const cv::Mat& img, uchar threshold_value)
+{
+    BinaryImage above = binary_threshold_packed(img, threshold_value);
+    if (above.empty())
+    {
+        return above;
+    }
+    return above.logical_not();
+}
+
 // ================ Limiarização para imagens coloridas ================
 
 cv::Mat ThresholdOperations::binary_threshold_color(const cv::Mat& img, uchar threshold_value, uchar max_value)
@@ -77,42 +536,273 @@ cv::Mat ThresholdOperations::apply_threshold(const cv::Mat& img, uchar threshold
         return cv::Mat();
     }
 
+    if (img.type() != CV_8UC1 && img.type() != CV_8UC3)
+    {
+        std::cerr << "Erro: Tipo de imagem não suportado (deve ser 1 ou 3 canais)!" << std::endl;
+        return cv::Mat();
+    }
+
     cv::Mat result(img.rows, img.cols, img.type());
 
-    if (img.channels() == 1) // Imagem em tons de cinza
+    // Despacho único por chamada para o kernel especializado no tipo;
+    // imagens coloridas usam o mesmo limiar em todos os canais.
+    switch (type)
     {
-        for (int linha = 0; linha < img.rows; linha++)
+    case BINARY:
+        threshold_image<BINARY>(img, result, threshold_value, max_value);
+        break;
+    case BINARY_INV:
+        threshold_image<BINARY_INV>(img, result, threshold_value, max_value);
+        break;
+    case TRUNCATE:
+        threshold_image<TRUNCATE>(img, result, threshold_value, max_value);
+        break;
+    case TO_ZERO:
+        threshold_image<TO_ZERO>(img, result, threshold_value, max_value);
+        break;
+    case TO_ZERO_INV:
+        threshold_image<TO_ZERO_INV>(img, result, threshold_value, max_value);
+        break;
+    default:
+        img.copyTo(result);
+        break;
+    }
+
+    return result;
+}
+
+PointLut ThresholdOperations::threshold_lut(uchar threshold_value, ThresholdType type, uchar max_value)
+{
+    PointLut::Table table;
+    for (int v = 0; v < 256; v++)
+    {
+        table[v] = apply_threshold_pixel(static_cast<uchar>(v), threshold_value, type, max_value);
+    }
+    return PointLut(table);
+}
+
+// ================ Limiarização automática ================
+
+bool ThresholdOperations::gray_and_histogram(const cv::Mat& img, cv::Mat& gray, std::vector<int>& histogram)
+{
+    if (img.empty())
+    {
+        std::cerr << "Erro: Imagem vazia!" << std::endl;
+        return false;
+    }
+
+    if (img.type() == CV_8UC1)
+    {
+        HistogramProcessor hist_proc;
+        gray = img;
+        histogram = hist_proc.compute_histogram_gray(img);
+        return !histogram.empty();
+    }
+
+    if (img.type() == CV_8UC3)
+    {
+        // Conversão e histograma na mesma passada
+        GrayScale converter(img);
+        gray = converter.get_gray_weighted_histogram(histogram);
+        return true;
+    }
+
+    std::cerr << "Erro: Tipo de imagem não suportado (deve ser CV_8UC1 ou CV_8UC3)!" << std::endl;
+    return false;
+}
+
+cv::Mat ThresholdOperations::otsu_threshold(const cv::Mat& img, uchar max_value)
+{
+    cv::Mat gray;
+    std::vector<int> histogram;
+    if (!gray_and_histogram(img, gray, histogram))
+    {
+        return cv::Mat();
+    }
+
+    return apply_threshold(gray, compute_otsu_threshold(histogram), BINARY, max_value);
+}
+
+cv::Mat ThresholdOperations::triangle_threshold(const cv::Mat& img, uchar max_value)
+{
+    cv::Mat gray;
+    std::vector<int> histogram;
+    if (!gray_and_histogram(img, gray, histogram))
+    {
+        return cv::Mat();
+    }
+
+    return apply_threshold(gray, compute_triangle_threshold(histogram), BINARY, max_value);
+}
+
+uchar ThresholdOperations::compute_otsu_threshold(const std::vector<int>& histogram)
+{
+    if (histogram.size() != 256)
+    {
+        std::cerr << "Erro: Histograma deve ter 256 elementos!" << std::endl;
+        return 0;
+    }
+
+    double total = 0.0;
+    double sum_total = 0.0;
+    for (int i = 0; i < 256; i++)
+    {
+        total += histogram[i];
+        sum_total += static_cast<double>(i) * histogram[i];
+    }
+
+    if (total == 0.0)
+    {
+        return 0;
+    }
+
+    // Varredura única: pesos e somas acumulados da classe "<= t"
+    double weight_low = 0.0;
+    double sum_low = 0.0;
+    double best_variance = -1.0;
+    int best_threshold = 0;
+
+    for (int t = 0; t < 256; t++)
+    {
+        weight_low += histogram[t];
+        sum_low += static_cast<double>(t) * histogram[t];
+
+        double weight_high = total - weight_low;
+        if (weight_low == 0.0 || weight_high == 0.0)
         {
-            const uchar* pixel_in = img.ptr<uchar>(linha);
-            uchar* pixel_out = result.ptr<uchar>(linha);
+            continue;
+        }
 
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                pixel_out[coluna] = apply_threshold_pixel(pixel_in[coluna], threshold_value, type, max_value);
-            }
+        double mean_low = sum_low / weight_low;
+        double mean_high = (sum_total - sum_low) / weight_high;
+        double diff = mean_low - mean_high;
+
+        // Variância entre classes (a menos do fator constante 1/total^2)
+        double variance = weight_low * weight_high * diff * diff;
+        if (variance > best_variance)
+        {
+            best_variance = variance;
+            best_threshold = t;
         }
     }
-    else if (img.channels() == 3) // Imagem colorida
+
+    return static_cast<uchar>(best_threshold);
+}
+
+uchar ThresholdOperations::compute_triangle_threshold(const std::vector<int>& histogram)
+{
+    if (histogram.size() != 256)
     {
-        for (int linha = 0; linha < img.rows; linha++)
-        {
-            const cv::Vec3b* pixel_in = img.ptr<cv::Vec3b>(linha);
-            cv::Vec3b* pixel_out = result.ptr<cv::Vec3b>(linha);
+        std::cerr << "Erro: Histograma deve ter 256 elementos!" << std::endl;
+        return 0;
+    }
 
-            for (int coluna = 0; coluna < img.cols; coluna++)
-            {
-                for (int canal = 0; canal < 3; canal++)
-                {
-                    pixel_out[coluna][canal] = apply_threshold_pixel(pixel_in[coluna][canal], threshold_value, type, max_value);
-                }
-            }
+    // Limites do suporte (primeiro e último bin não nulos, com uma margem)
+    int left_bound = 0;
+    int right_bound = 255;
+    while (left_bound < 256 && histogram[left_bound] == 0) left_bound++;
+    if (left_bound == 256)
+    {
+        return 0;
+    }
+    while (right_bound > 0 && histogram[right_bound] == 0) right_bound--;
+    if (left_bound > 0) left_bound--;
+    if (right_bound < 255) right_bound++;
+
+    int peak = static_cast<int>(std::max_element(histogram.begin(), histogram.end()) - histogram.begin());
+
+    // O triângulo é traçado do pico até a cauda mais longa; espelha o
+    // histograma para que a cauda fique sempre à esquerda.
+    std::vector<int> hist(histogram);
+    bool flipped = false;
+    if (peak - left_bound < right_bound - peak)
+    {
+        flipped = true;
+        std::reverse(hist.begin(), hist.end());
+        left_bound = 255 - right_bound;
+        peak = 255 - peak;
+    }
+
+    // Maior distância entre a reta (left_bound, 0)-(peak, h[peak]) e o histograma
+    int threshold = left_bound;
+    double a = hist[peak];
+    double b = left_bound - peak;
+    double max_distance = 0.0;
+    for (int i = left_bound + 1; i <= peak; i++)
+    {
+        double distance = a * i + b * hist[i];
+        if (distance > max_distance)
+        {
+            max_distance = distance;
+            threshold = i;
         }
     }
-    else
+    threshold--;
+
+    if (flipped)
     {
-        std::cerr << "Erro: Tipo de imagem não suportado (deve ser 1 ou 3 canais)!" << std::endl;
+        threshold = 255 - threshold;
+    }
+
+    return static_cast<uchar>(std::max(0, std::min(255, threshold)));
+}
+
+// ================ Limiarização adaptativa (local) ================
+
+cv::Mat ThresholdOperations::adaptive_mean_threshold(const cv::Mat& img, int block_size, double c, uchar max_value, bool low_memory)
+{
+    return adaptive_threshold(img, block_size, false, c, 1.0, max_value, low_memory);
+}
+
+cv::Mat ThresholdOperations::sauvola_threshold(const cv::Mat& img, int block_size, double k, double r, uchar max_value, bool low_memory)
+{
+    return adaptive_threshold(img, block_size, true, k, r, max_value, low_memory);
+}
+
+cv::Mat ThresholdOperations::adaptive_threshold(const cv::Mat& img, int block_size, bool sauvola, double param, double range, uchar max_value, bool low_memory)
+{
+    if (img.empty())
+    {
+        std::cerr << "Erro: Imagem vazia!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (img.type() != CV_8UC1)
+    {
+        std::cerr << "Erro: Limiarização adaptativa exige imagem em tons de cinza (CV_8UC1)!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (block_size < 3 || block_size % 2 == 0)
+    {
+        std::cerr << "Erro: Tamanho da janela deve ser ímpar e >= 3!" << std::endl;
         return cv::Mat();
     }
 
+    if (block_size > MAX_ADAPTIVE_BLOCK)
+    {
+        std::cerr << "Erro: Tamanho da janela deve ser <= " << MAX_ADAPTIVE_BLOCK << "!" << std::endl;
+        return cv::Mat();
+    }
+
+    if (sauvola && range <= 0.0)
+    {
+        std::cerr << "Erro: Parâmetro r de Sauvola deve ser positivo!" << std::endl;
+        return cv::Mat();
+    }
+
+    cv::Mat result(img.rows, img.cols, CV_8UC1);
+    LocalRule rule{ sauvola, param, range, max_value };
+    const int radius = block_size / 2;
+
+    if (low_memory)
+    {
+        adaptive_band(img, result, radius, rule);
+    }
+    else
+    {
+        adaptive_full(img, result, radius, rule);
+    }
+
     return result;
 }